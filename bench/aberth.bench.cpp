@@ -0,0 +1,57 @@
+#include "aberth.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+/// @brief coefficients uniform in [-1, 1), the same for every run
+std::vector<double> polynomial(const std::size_t degree) {
+  std::mt19937_64                  random{42};
+  std::uniform_real_distribution<> coefficient{-1, 1};
+  std::vector<double>              coefficients(degree + 1);
+
+  for (auto& c : coefficients) {
+    c = coefficient(random);
+  }
+  return coefficients;
+}
+
+/// @brief time to solution against degree; range(1) is the number of
+/// threads, 1 for the serial iteration
+void solve(benchmark::State& state) {
+  const auto          degree = static_cast<std::size_t>(state.range(0));
+  const auto          threads = static_cast<unsigned>(state.range(1));
+  const auto          coefficients = polynomial(degree);
+  utils::Convergence  convergence{};
+  unsigned            iterations{0};
+
+  convergence.threads = threads;
+  convergence.parallel_degree = threads > 1 ? 0 : degree + 1;
+  for (auto _ : state) {
+    const auto roots = utils::polynomial_roots(coefficients, convergence);
+
+    iterations = roots.iterations;
+    benchmark::DoNotOptimize(roots.real.data());
+  }
+  state.counters["aberth_iterations"] = iterations;
+  state.SetComplexityN(state.range(0));
+}
+
+}  // namespace
+
+static void BM_polynomialRoots(benchmark::State& state) { solve(state); }
+BENCHMARK(BM_polynomialRoots)
+    ->ArgsProduct({benchmark::CreateRange(8, 4096, 4), {1}})
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oNSquared);
+
+static void BM_polynomialRootsThreaded(benchmark::State& state) {
+  solve(state);
+}
+BENCHMARK(BM_polynomialRootsThreaded)
+    ->ArgsProduct({benchmark::CreateRange(512, 4096, 2), {4}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
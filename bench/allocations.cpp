@@ -0,0 +1,39 @@
+#include "allocations.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::size_t> allocated{0};
+
+}  // namespace
+
+void *operator new(const std::size_t size) {
+  allocated.fetch_add(1, std::memory_order_relaxed);
+  if (void *memory = std::malloc(size ? size : 1)) {
+    return memory;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+
+void operator delete(void *memory, std::size_t) noexcept { std::free(memory); }
+
+namespace allocations {
+
+std::size_t count() { return allocated.load(std::memory_order_relaxed); }
+
+/* Counter */
+
+Counter::Counter() : start{count()} {}
+
+void Counter::report(benchmark::State &state) const {
+  state.counters["allocs_per_iter"] =
+      benchmark::Counter(static_cast<double>(count() - start),
+                         benchmark::Counter::kAvgIterations);
+}
+
+}  // namespace allocations
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+/// @brief heap allocations of the benchmark binary, counted by its replaced
+/// global operator new
+namespace allocations {
+
+/// @brief number of allocations made so far, on any thread
+std::size_t count();
+
+/// @brief reports the allocations made between its construction and report()
+/// as an average per iteration
+class Counter {
+ public:
+  Counter();
+
+  void report(benchmark::State &state) const;
+
+ private:
+  std::size_t start;
+};
+
+}  // namespace allocations
@@ -0,0 +1,219 @@
+#include "batch.h"
+#include "binary.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cctype>
+#include <sstream>
+#include <thread>
+
+#include "allocations.h"
+#include "writer.h"
+
+namespace {
+
+/// @brief a mix of quadratic, linear, complex and malformed equations
+std::string equations(const std::size_t count) {
+  constexpr std::string_view lines[]{
+      "1 * X^2 - 3 * X^1 - 4 * X^0 = 0\n",
+      "5 * X^0 + 4 * X^1 - 9.3 * X^2 = 1 * X^0\n",
+      "84 * X^1 - 20 * X^0 = 42 * X^1 - 10 * X^0\n",
+      "3 * X^2 + 3 * X^1 + 4 * X^0 = 0\n",
+      "1 * X^2 + 2 * X\n",
+  };
+  std::string input;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    input += lines[i % std::size(lines)];
+  }
+  return input;
+}
+
+/// @brief valid quadratics with one line in every 100 / percent malformed
+std::string malformed(const std::size_t count, const std::size_t percent) {
+  constexpr std::string_view valid{"1 * X^2 - 3 * X^1 - 4 * X^0 = 0\n"};
+  constexpr std::string_view invalid[]{
+      "1 * X^2 - 3 * X^1 - 4 * X^0 = 0 $\n",
+      "1 * X^2 - 3 * X 1 - 4 * X^0 = 0\n",
+      "1 * X^2 - 3 * X^1 + 1 * Y^1 = 0\n",
+      "1 * X^2 - 3 * X^1 - 4 * X^0\n",
+  };
+  std::string input;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    if (percent && (i * percent) % 100 < percent) {
+      input += invalid[i % std::size(invalid)];
+    } else {
+      input += valid;
+    }
+  }
+  return input;
+}
+
+/// @brief record through the throwing interfaces, the way batch::record
+/// worked before invalid equations were reported through a Status
+void recordThrowing(const std::size_t number, std::string_view line,
+                    std::ostream& os) {
+  os << number << ": ";
+  try {
+    Parser      par{line};
+    Interpreter interp{};
+
+    if (!interp.reduce(par)) {
+      throw grammarError("quit is not an equation");
+    }
+    interp.solve();
+    const auto solutions = interp.getSolutions();
+    for (std::size_t i = 0; i < solutions.size(); ++i) {
+      if (i) {
+        os << ", ";
+      }
+      std::visit([&os](const auto& solution) { os << solution; },
+                 solutions.at(i));
+    }
+    os << '\n';
+  } catch (const std::exception& e) {
+    std::string_view message{e.what()};
+
+    while (!message.empty() && std::isspace(message.back())) {
+      message.remove_suffix(1);
+    }
+    os << "error: " << message << '\n';
+  }
+}
+
+template <typename Record>
+void malformedThroughput(benchmark::State& state, Record&& record) {
+  constexpr std::size_t lines{1 << 12};
+  const std::string     input =
+      malformed(lines, static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    std::ostringstream os;
+    std::string_view   rest{input};
+
+    for (std::size_t number = 1; !rest.empty(); ++number) {
+      record(number, batch::nextLine(rest), os);
+    }
+    benchmark::DoNotOptimize(os);
+  }
+  state.SetItemsProcessed(state.iterations() * lines);
+}
+
+}  // namespace
+
+/// @brief records per second against the percentage of malformed lines,
+/// errors reported through a Status
+static void BM_recordMalformed(benchmark::State& state) {
+  malformedThroughput(state, [](const std::size_t number,
+                                std::string_view line, std::ostream& os) {
+    batch::record(number, line, os);
+  });
+}
+BENCHMARK(BM_recordMalformed)->Arg(0)->Arg(5)->Arg(20)->Arg(100);
+
+/// @brief the same, errors thrown and caught
+static void BM_recordMalformedThrowing(benchmark::State& state) {
+  malformedThroughput(state, recordThrowing);
+}
+BENCHMARK(BM_recordMalformedThrowing)->Arg(0)->Arg(5)->Arg(20)->Arg(100);
+
+/// @brief batch throughput against the number of workers
+static void BM_batchScaling(benchmark::State& state) {
+  const std::string input = equations(1 << 16);
+
+  for (auto _ : state) {
+    std::ostringstream os;
+
+    batch::run(input, os, static_cast<unsigned>(state.range(0)));
+    benchmark::DoNotOptimize(os);
+  }
+  state.SetItemsProcessed(state.iterations() * (1 << 16));
+}
+BENCHMARK(BM_batchScaling)
+    ->RangeMultiplier(2)
+    ->Range(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+namespace {
+
+/// @brief count quadratics with small integer coefficients, as text lines
+/// and as binary records
+struct Quadratics {
+  std::string text;
+  std::string binary;
+
+  Quadratics(const std::size_t count) {
+    binary::appendHeader(binary, 2, count);
+    for (std::size_t i = 0; i < count; ++i) {
+      const std::vector<double> coefficients{
+          static_cast<double>(i % 7) - 3, static_cast<double>(i % 5) - 2,
+          static_cast<double>(i % 3) + 1};
+
+      text += std::to_string(static_cast<int>(coefficients[0])) +
+              " * X^0 + " + std::to_string(static_cast<int>(coefficients[1])) +
+              " * X^1 + " + std::to_string(static_cast<int>(coefficients[2])) +
+              " * X^2 = 0\n";
+      binary::appendRecord(binary, 2, 'X', coefficients);
+    }
+  }
+};
+
+}  // namespace
+
+/// @brief the same quadratics lexed and parsed from text, without a cache
+static void BM_textQuadratics(benchmark::State& state) {
+  const Quadratics input{1 << 14};
+
+  for (auto _ : state) {
+    std::ostringstream os;
+    std::string_view   rest{input.text};
+
+    for (std::size_t number = 1; !rest.empty(); ++number) {
+      batch::record(number, batch::nextLine(rest), os);
+    }
+    benchmark::DoNotOptimize(os);
+  }
+  state.SetItemsProcessed(state.iterations() * (1 << 14));
+}
+BENCHMARK(BM_textQuadratics)->Unit(benchmark::kMillisecond);
+
+/// @brief the same text records written through one Writer into a reused
+/// string: no allocation per record once the string has grown
+static void BM_textQuadraticsWriter(benchmark::State& state) {
+  const Quadratics           input{1 << 14};
+  std::string                output;
+  const allocations::Counter allocs{};
+
+  for (auto _ : state) {
+    std::string_view rest{input.text};
+
+    output.clear();
+    {
+      Writer out{output};
+
+      for (std::size_t number = 1; !rest.empty(); ++number) {
+        batch::record(number, batch::nextLine(rest), out);
+      }
+    }
+    benchmark::DoNotOptimize(output);
+  }
+  allocs.report(state);
+  state.SetItemsProcessed(state.iterations() * (1 << 14));
+}
+BENCHMARK(BM_textQuadraticsWriter)->Unit(benchmark::kMillisecond);
+
+/// @brief ... and read from binary records by the vectorised solver
+static void BM_binaryQuadratics(benchmark::State& state) {
+  const Quadratics input{1 << 14};
+
+  for (auto _ : state) {
+    std::ostringstream os;
+
+    binary::run(input.binary, os);
+    benchmark::DoNotOptimize(os);
+  }
+  state.SetItemsProcessed(state.iterations() * (1 << 14));
+}
+BENCHMARK(BM_binaryQuadratics)->Unit(benchmark::kMillisecond);
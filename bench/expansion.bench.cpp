@@ -0,0 +1,105 @@
+#include "expansion.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "parser.h"
+#include "visitors.h"
+
+namespace {
+
+/// @brief small integer coefficients, so every method is exact and the
+/// number theoretic transform applies
+std::vector<double> polynomial(const std::size_t degree, const unsigned seed) {
+  std::mt19937_64                    random{seed};
+  std::uniform_int_distribution<int> coefficient{-9, 9};
+  std::vector<double>                coefficients(degree + 1);
+
+  for (auto& c : coefficients) {
+    c = coefficient(random);
+  }
+  return coefficients;
+}
+
+/// @brief time to multiply two polynomials of range(0) degree
+void multiply(benchmark::State& state, const utils::Product algorithm) {
+  const auto          degree = static_cast<std::size_t>(state.range(0));
+  const auto          a = polynomial(degree, 1);
+  const auto          b = polynomial(degree, 2);
+  std::vector<double> product;
+
+  for (auto _ : state) {
+    utils::polynomial_product(a, b, product, algorithm);
+    benchmark::DoNotOptimize(product.data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+/// @brief "(1 * X^d - 2) * (1 * X^d + 1)^4 = 0", whose expansion goes
+/// through dense products of degree d and up
+std::string groups(const std::size_t degree) {
+  const std::string power = "X^" + std::to_string(degree);
+
+  return "(1 * " + power + " - 2) * (1 * " + power + " + 1)^4 = 0";
+}
+
+}  // namespace
+
+static void BM_multiplySchoolbook(benchmark::State& state) {
+  multiply(state, utils::Product::kSchoolbook);
+}
+BENCHMARK(BM_multiplySchoolbook)
+    ->RangeMultiplier(4)
+    ->Range(16, 16384)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oNSquared);
+
+static void BM_multiplyKaratsuba(benchmark::State& state) {
+  multiply(state, utils::Product::kKaratsuba);
+}
+BENCHMARK(BM_multiplyKaratsuba)
+    ->RangeMultiplier(4)
+    ->Range(16, 65536)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
+
+static void BM_multiplyNtt(benchmark::State& state) {
+  multiply(state, utils::Product::kNtt);
+}
+BENCHMARK(BM_multiplyNtt)
+    ->RangeMultiplier(4)
+    ->Range(16, 262144)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oNLogN);
+
+static void BM_multiply(benchmark::State& state) {
+  multiply(state, utils::Product::kAuto);
+}
+BENCHMARK(BM_multiply)
+    ->RangeMultiplier(4)
+    ->Range(16, 262144)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oNLogN);
+
+/// @brief expansion time against degree, parsing and reduction included
+static void BM_reduceGroups(benchmark::State& state) {
+  const std::string input = groups(static_cast<std::size_t>(state.range(0)));
+  Parser            par{};
+
+  for (auto _ : state) {
+    RpnVisitor rpn{};
+
+    par.stream(input);
+    par.reduce(rpn);
+    benchmark::DoNotOptimize(rpn.terms);
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_reduceGroups)
+    ->RangeMultiplier(8)
+    ->Range(8, 131072)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity(benchmark::oNLogN);
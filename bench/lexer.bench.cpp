@@ -0,0 +1,60 @@
+#include "lexer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+
+namespace {
+
+/// @brief an equation that is mostly number literals
+std::string numbers(const std::size_t count) {
+  std::string input;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    input += std::to_string(i * 7919 % 100000) + "." +
+             std::to_string(i % 1000) + " * X^" + std::to_string(i % 3) +
+             " + ";
+  }
+  return input + "0 = 0";
+}
+
+}  // namespace
+
+static void BM_lexNumbers(benchmark::State& state) {
+  const std::string input = numbers(static_cast<std::size_t>(state.range(0)));
+  Lexer             lexer{};
+
+  for (auto _ : state) {
+    lexer.stream(input);
+    for (Token token = lexer.get(); token.kind != Token::Kind::kEnd;
+         token = lexer.get()) {
+      benchmark::DoNotOptimize(token);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_lexNumbers)->Arg(1000)->Arg(100000);
+
+/// @brief the istringstream extraction the lexer used to rely on
+static void BM_streamNumbers(benchmark::State& state) {
+  const std::string input = numbers(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    std::istringstream scanner{input};
+    double             d{0};
+    char               ch{0};
+
+    while (scanner.get(ch)) {
+      if (ch >= '0' && ch <= '9') {
+        scanner.unget();
+        scanner >> d;
+        benchmark::DoNotOptimize(d);
+      }
+    }
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_streamNumbers)->Arg(1000)->Arg(100000);
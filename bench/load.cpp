@@ -0,0 +1,132 @@
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using steady_t = std::chrono::steady_clock;
+
+constexpr std::string_view usage{
+    "usage: ./computorv1_load <socket> [clients] [requests per client] "
+    "[equation]"};
+
+struct Result {
+  std::vector<double> latencies;
+  std::size_t         errors{0};
+};
+
+int connect(const std::string& path) {
+  sockaddr_un address{};
+
+  if (path.size() >= sizeof(address.sun_path)) {
+    throw std::invalid_argument("socket path is too long: " + path);
+  }
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+  if (fd == -1 || ::connect(fd, reinterpret_cast<const sockaddr*>(&address),
+                            sizeof(address)) == -1) {
+    throw std::system_error(errno, std::generic_category(), path);
+  }
+  return fd;
+}
+
+/// @brief closed-loop client of computorv1 --serve: send one equation, wait
+/// for its reply, send the next; times each round trip in microseconds
+void client(const std::string& path, const std::size_t requests,
+            const std::string& line, Result& result) {
+  const int   fd = connect(path);
+  std::string reply;
+  char        buffer[4096];
+
+  result.latencies.reserve(requests);
+  for (std::size_t i = 0; i < requests; ++i) {
+    const auto start = steady_t::now();
+
+    if (::send(fd, line.data(), line.size(), MSG_NOSIGNAL) !=
+        static_cast<ssize_t>(line.size())) {
+      throw std::system_error(errno, std::generic_category(), "send");
+    }
+    std::size_t end{std::string::npos};
+    while ((end = reply.find('\n')) == std::string::npos) {
+      const ssize_t count = ::read(fd, buffer, sizeof(buffer));
+
+      if (count <= 0) {
+        throw std::runtime_error("server closed the connection");
+      }
+      reply.append(buffer, static_cast<std::size_t>(count));
+    }
+    result.latencies.push_back(
+        std::chrono::duration<double, std::micro>(steady_t::now() - start)
+            .count());
+    if (reply.find(": error: ") < end) {
+      ++result.errors;
+    }
+    reply.erase(0, end + 1);
+  }
+  ::close(fd);
+}
+
+double percentile(const std::vector<double>& sorted, const double p) {
+  return sorted[static_cast<std::size_t>(p * (sorted.size() - 1))];
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) try {
+  if (argc < 2 || argc > 5) {
+    throw std::invalid_argument(std::string{usage});
+  }
+  const std::string path{argv[1]};
+  const std::size_t clients = argc > 2 ? std::stoul(argv[2]) : 4;
+  const std::size_t requests = argc > 3 ? std::stoul(argv[3]) : 10000;
+  const std::string line =
+      std::string{argc > 4 ? argv[4]
+                           : "5 * X^0 + 4 * X^1 - 9.3 * X^2 = 1 * X^0"} +
+      '\n';
+  std::vector<Result>      results(clients);
+  std::vector<std::thread> threads;
+
+  const auto start = steady_t::now();
+  for (std::size_t i = 0; i < clients; ++i) {
+    threads.emplace_back(client, path, requests, line, std::ref(results[i]));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const std::chrono::duration<double> elapsed = steady_t::now() - start;
+
+  std::vector<double> latencies;
+  std::size_t         errors{0};
+  for (const auto& result : results) {
+    latencies.insert(latencies.end(), result.latencies.begin(),
+                     result.latencies.end());
+    errors += result.errors;
+  }
+  if (latencies.empty()) {
+    return 0;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  std::cout << "requests: " << latencies.size() << " (" << errors
+            << " errors) in " << elapsed.count() << " s, "
+            << latencies.size() / elapsed.count() << " req/s\n"
+            << "latency us: p50 " << percentile(latencies, 0.50) << ", p95 "
+            << percentile(latencies, 0.95) << ", p99 "
+            << percentile(latencies, 0.99) << ", max " << latencies.back()
+            << '\n';
+  return 0;
+} catch (std::exception& e) {
+  std::cerr << e.what() << '\n';
+  return 1;
+}
@@ -0,0 +1,149 @@
+#include "numeric.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+/// @brief the Newton iteration utils::squareroot used before numeric::sqrt
+double newton(const double num) {
+  double guess = num;
+
+  while (std::abs(num - guess * guess) > 1e-6) {
+    guess = (guess + num / guess) * 0.5;
+  }
+  return guess;
+}
+
+/// @brief the linear loop utils::exponentiation used before numeric::power
+double linear(const double b, const unsigned n) {
+  double result{1};
+
+  for (unsigned i = 0; i < n; ++i) {
+    result *= b;
+  }
+  return result;
+}
+
+/// @brief distance between two finite doubles of the same sign in units in
+/// the last place
+std::int64_t ulps(const double x, const double y) {
+  std::int64_t a{0};
+  std::int64_t b{0};
+
+  std::memcpy(&a, &x, sizeof(a));
+  std::memcpy(&b, &y, sizeof(b));
+  return a > b ? a - b : b - a;
+}
+
+std::vector<double> operands(const std::size_t n) {
+  std::vector<double> values(n);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    values[i] = static_cast<double>(i % 1000) * 0.37 + 0.5;
+  }
+  return values;
+}
+
+}  // namespace
+
+static void BM_sqrtNewton(benchmark::State& state) {
+  const auto   values = operands(1024);
+  std::int64_t worst{0};
+
+  for (const double value : values) {
+    worst = std::max(worst, ulps(newton(value), std::sqrt(value)));
+  }
+  for (auto _ : state) {
+    for (const double value : values) {
+      benchmark::DoNotOptimize(newton(value));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+  state.counters["max_ulp"] = static_cast<double>(worst);
+}
+BENCHMARK(BM_sqrtNewton);
+
+static void BM_sqrtNumeric(benchmark::State& state) {
+  const auto   values = operands(1024);
+  std::int64_t worst{0};
+
+  for (const double value : values) {
+    worst = std::max(worst, ulps(numeric::sqrt(value), std::sqrt(value)));
+  }
+  for (auto _ : state) {
+    for (const double value : values) {
+      benchmark::DoNotOptimize(numeric::sqrt(value));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+  state.counters["max_ulp"] = static_cast<double>(worst);
+}
+BENCHMARK(BM_sqrtNumeric);
+
+static void BM_powerLinear(benchmark::State& state) {
+  const auto n = static_cast<unsigned>(state.range(0));
+  double     base{1.0001};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(base);
+    benchmark::DoNotOptimize(linear(base, n));
+  }
+  state.counters["max_ulp"] =
+      static_cast<double>(ulps(linear(base, n), std::pow(base, n)));
+}
+BENCHMARK(BM_powerLinear)->Arg(2)->Arg(16)->Arg(62);
+
+static void BM_powerSquaring(benchmark::State& state) {
+  const auto n = static_cast<unsigned>(state.range(0));
+  double     base{1.0001};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(base);
+    benchmark::DoNotOptimize(numeric::power(base, n));
+  }
+  state.counters["max_ulp"] =
+      static_cast<double>(ulps(numeric::power(base, n), std::pow(base, n)));
+}
+BENCHMARK(BM_powerSquaring)->Arg(2)->Arg(16)->Arg(62);
+
+static void BM_powerStd(benchmark::State& state) {
+  const auto n = static_cast<unsigned>(state.range(0));
+  double     base{1.0001};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(base);
+    benchmark::DoNotOptimize(std::pow(base, n));
+  }
+}
+BENCHMARK(BM_powerStd)->Arg(2)->Arg(16)->Arg(62);
+
+/// @brief accuracy of the small root of x^2 + b x + 1 = 0 for growing b, where
+/// the classic formula cancels; the reference is the rationalised form
+/// evaluated in long double
+static void BM_quadraticAccuracy(benchmark::State& state) {
+  const double b = std::pow(10.0, static_cast<double>(state.range(0)));
+  const long double wide = static_cast<long double>(b);
+  const double reference = static_cast<double>(
+      -2.0L / (wide + std::sqrt(wide * wide - 4.0L)));
+  const double classic = (-b + std::sqrt(b * b - 4)) / 2;
+  double       plus{0};
+  double       minus{0};
+
+  for (auto _ : state) {
+    numeric::quadratic_roots(1, b, 1,
+                             numeric::sqrt(numeric::discriminant(1, b, 1)),
+                             plus, minus);
+    benchmark::DoNotOptimize(plus);
+    benchmark::DoNotOptimize(minus);
+  }
+  state.counters["classic_rel_err"] =
+      std::abs((classic - reference) / reference);
+  state.counters["stable_rel_err"] = std::abs((plus - reference) / reference);
+}
+BENCHMARK(BM_quadraticAccuracy)->DenseRange(2, 8, 2);
@@ -0,0 +1,232 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "allocations.h"
+#include "computor.h"
+#include "incremental.h"
+#include "interpreter.h"
+#include "lexer.h"
+#include "parser.h"
+#include "visitors.h"
+
+namespace {
+
+/// @brief the equations of the subject
+std::string realistic() {
+  return "5 * X^0 + 4 * X^1 - 9.3 * X^2 = 1 * X^0";
+}
+
+/// @brief double negations, long literals and high degree terms that cancel,
+/// repeated count times
+std::string pathological(const std::size_t count) {
+  std::string input{"1 * X^2"};
+
+  for (std::size_t i = 0; i < count; ++i) {
+    input += " + - - 123456789.123456789 * X^" + std::to_string(i % 2) +
+             " + 1 * X^5000 - 1 * X^5000";
+  }
+  return input + " = 0.000000000000000000000001 * X^0";
+}
+
+/// @brief "1 * X^0 + 2 * X^1 + 3 * X^2 + ... = 0" with count terms
+std::string long_equation(const std::size_t count) {
+  std::string input;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    input += std::to_string(i % 97 + 1) + " * X^" + std::to_string(i % 3) +
+             " + ";
+  }
+  return input + "1 * X^2 = 0";
+}
+
+/// @brief count terms over twelve named variables, in a few hundred distinct
+/// monomials
+std::string multivariate(const std::size_t count) {
+  static constexpr const char* names[] = {
+      "alpha", "beta", "gamma", "delta", "epsilon", "zeta",
+      "eta",   "theta", "iota", "kappa", "lambda",  "mu"};
+  std::string input;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    input += std::to_string(i % 97 + 1) + " * " + names[i % 12] + "^" +
+             std::to_string(i % 29) + " + ";
+  }
+  return input + "1 * alpha^2 = 0";
+}
+
+}  // namespace
+
+/* stages */
+
+static void BM_lex(benchmark::State& state, const std::string& input) {
+  Lexer                      lexer{};
+  const allocations::Counter allocs{};
+
+  for (auto _ : state) {
+    lexer.stream(input);
+    for (Token token = lexer.get(); token.kind != Token::Kind::kEnd;
+         token = lexer.get()) {
+      benchmark::DoNotOptimize(token);
+    }
+  }
+  allocs.report(state);
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(input.size()));
+}
+BENCHMARK_CAPTURE(BM_lex, realistic, realistic());
+BENCHMARK_CAPTURE(BM_lex, pathological, pathological(1000));
+BENCHMARK_CAPTURE(BM_lex, long, long_equation(100000));
+
+static void BM_parse(benchmark::State& state, const std::string& input) {
+  Parser                     par{};
+  const allocations::Counter allocs{};
+
+  for (auto _ : state) {
+    par.stream(input);
+    benchmark::DoNotOptimize(par.parse());
+  }
+  allocs.report(state);
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(input.size()));
+}
+BENCHMARK_CAPTURE(BM_parse, realistic, realistic());
+BENCHMARK_CAPTURE(BM_parse, pathological, pathological(1000));
+BENCHMARK_CAPTURE(BM_parse, long, long_equation(100000));
+
+/// @brief RpnVisitor over an already parsed and transposed tree
+static void BM_reduce(benchmark::State& state, const std::string& input) {
+  Parser par{input};
+
+  par.parse();
+  Tree& tree = par.getTree();
+  TransposeVisitor{}(tree);
+  const allocations::Counter allocs{};
+
+  for (auto _ : state) {
+    RpnVisitor rpn{};
+
+    rpn(tree);
+    benchmark::DoNotOptimize(rpn.terms);
+  }
+  allocs.report(state);
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(tree.getNodes().size()));
+}
+BENCHMARK_CAPTURE(BM_reduce, realistic, realistic());
+BENCHMARK_CAPTURE(BM_reduce, pathological, pathological(1000));
+BENCHMARK_CAPTURE(BM_reduce, long, long_equation(100000));
+
+/// @brief the streaming parser folding straight into an RpnVisitor
+static void BM_reduceStreaming(benchmark::State& state,
+                               const std::string& input) {
+  Parser                     par{};
+  const allocations::Counter allocs{};
+
+  for (auto _ : state) {
+    RpnVisitor rpn{};
+
+    par.stream(input);
+    par.reduce(rpn);
+    benchmark::DoNotOptimize(rpn.terms);
+  }
+  allocs.report(state);
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(input.size()));
+}
+BENCHMARK_CAPTURE(BM_reduceStreaming, realistic, realistic());
+BENCHMARK_CAPTURE(BM_reduceStreaming, pathological, pathological(1000));
+BENCHMARK_CAPTURE(BM_reduceStreaming, long, long_equation(100000));
+BENCHMARK_CAPTURE(BM_reduceStreaming, multivariate, multivariate(5000));
+
+/* end to end */
+
+/// @brief parse, reduce and solve the way batch mode does
+static void BM_solveEquation(benchmark::State& state,
+                             const std::string& input) {
+  Parser                     par{};
+  const allocations::Counter allocs{};
+
+  for (auto _ : state) {
+    Interpreter interp{};
+
+    par.stream(input);
+    interp.reduce(par);
+    interp.solve();
+    benchmark::DoNotOptimize(interp.getSolutions());
+  }
+  allocs.report(state);
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(input.size()));
+}
+BENCHMARK_CAPTURE(BM_solveEquation, realistic, realistic());
+BENCHMARK_CAPTURE(BM_solveEquation, pathological, pathological(1000));
+BENCHMARK_CAPTURE(BM_solveEquation, long, long_equation(100000));
+
+/// @brief parse into a tree, transpose, reduce and solve the way the prompt
+/// does
+static void BM_solveEquationTree(benchmark::State& state,
+                                 const std::string& input) {
+  Parser                     par{};
+  const allocations::Counter allocs{};
+
+  for (auto _ : state) {
+    par.stream(input);
+    par.parse();
+    Interpreter interp{par.getTree()};
+
+    interp.reduce();
+    interp.solve();
+    benchmark::DoNotOptimize(interp.getSolutions());
+  }
+  allocs.report(state);
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(input.size()));
+}
+BENCHMARK_CAPTURE(BM_solveEquationTree, realistic, realistic());
+BENCHMARK_CAPTURE(BM_solveEquationTree, pathological, pathological(1000));
+BENCHMARK_CAPTURE(BM_solveEquationTree, long, long_equation(100000));
+
+/// @brief a digit in the middle of a long equation edited back and forth,
+/// each version reduced from the previous one; BM_reduceStreaming/long
+/// reduces it whole
+static void BM_reduceEdit(benchmark::State& state) {
+  std::string       versions[2]{long_equation(100000), long_equation(100000)};
+  const std::size_t digit =
+      versions[1].find_first_of("123456789", versions[1].size() / 2);
+  Incremental edits{};
+  std::size_t edit{0};
+
+  versions[1][digit] = versions[1][digit] == '9' ? '8' : '9';
+  edits.reduce(versions[0]);
+  const allocations::Counter allocs{};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(edits.reduce(versions[++edit % 2]));
+  }
+  allocs.report(state);
+  state.counters["incremental"] = edits.reused();
+}
+BENCHMARK(BM_reduceEdit);
+
+/// @brief the realistic equation solved at compile time, against the same
+/// literal solved by computor::solve at runtime
+static void BM_solveLiteral(benchmark::State& state) {
+  for (auto _ : state) {
+    constexpr auto solution =
+        computor::solve("5 * X^0 + 4 * X^1 - 9.3 * X^2 = 1 * X^0");
+
+    benchmark::DoNotOptimize(solution);
+  }
+}
+BENCHMARK(BM_solveLiteral);
+
+static void BM_solveLiteralRuntime(benchmark::State& state) {
+  std::string_view input{"5 * X^0 + 4 * X^1 - 9.3 * X^2 = 1 * X^0"};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(input);
+    benchmark::DoNotOptimize(computor::solve(input));
+  }
+}
+BENCHMARK(BM_solveLiteralRuntime);
@@ -0,0 +1,92 @@
+#include "quadratic.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "allocations.h"
+#include "utils.h"
+
+namespace {
+
+struct Coefficients {
+  std::vector<double> a;
+  std::vector<double> b;
+  std::vector<double> c;
+
+  Coefficients(const std::size_t n) : a(n), b(n), c(n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      a[i] = static_cast<double>(i % 9) + 1;
+      b[i] = static_cast<double>(i % 13) - 6;
+      c[i] = static_cast<double>(i % 7) - 3;
+    }
+  }
+};
+
+}  // namespace
+
+static void BM_quadraticScalar(benchmark::State& state) {
+  const Coefficients coefficients{static_cast<std::size_t>(state.range(0))};
+  const allocations::Counter allocs{};
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < coefficients.a.size(); ++i) {
+      benchmark::DoNotOptimize(utils::quadratic_equation_solver(
+          coefficients.a[i], coefficients.b[i], coefficients.c[i]));
+    }
+  }
+  allocs.report(state);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_quadraticScalar)->Arg(1 << 16);
+
+static void BM_quadraticBatch(benchmark::State& state) {
+  const auto         n = static_cast<std::size_t>(state.range(0));
+  const Coefficients coefficients{n};
+  std::vector<double>       root1(n);
+  std::vector<double>       root2(n);
+  std::vector<double>       imag(n);
+  std::vector<utils::Roots> kind(n);
+
+  for (auto _ : state) {
+    utils::quadratic_batch_solver(coefficients.a.data(), coefficients.b.data(),
+                                  coefficients.c.data(), n, root1.data(),
+                                  root2.data(), imag.data(), kind.data());
+    benchmark::DoNotOptimize(root1.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_quadraticBatch)->Arg(1 << 16);
+
+/// @brief the batch solver when range(1) percent of the quadratics have a
+/// doubtful discriminant, alternately settled in double-double and exactly
+static void BM_quadraticEscalation(benchmark::State& state) {
+  const auto                n = static_cast<std::size_t>(state.range(0));
+  const auto                percent = static_cast<std::size_t>(state.range(1));
+  const double              b = 0x9000000000001p0;
+  Coefficients              coefficients{n};
+  std::vector<double>       root1(n);
+  std::vector<double>       root2(n);
+  std::vector<double>       imag(n);
+  std::vector<utils::Roots> kind(n);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    if (i * percent % 100 + percent >= 100) {
+      coefficients.a[i] = i % 2 ? 0x1.d508fc881e90cp+0 : (b - 1) / 2;
+      coefficients.b[i] = i % 2 ? 0x1.f4bcec7689362p+1 : b;
+      coefficients.c[i] = i % 2 ? 0x1.0b4ab727f4979p+1 : (b + 1) / 2;
+    }
+  }
+  for (auto _ : state) {
+    utils::quadratic_batch_solver(coefficients.a.data(), coefficients.b.data(),
+                                  coefficients.c.data(), n, root1.data(),
+                                  root2.data(), imag.data(), kind.data());
+    benchmark::DoNotOptimize(root1.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_quadraticEscalation)
+    ->Args({1 << 16, 0})
+    ->Args({1 << 16, 1})
+    ->Args({1 << 16, 10})
+    ->Args({1 << 16, 100});
@@ -0,0 +1,157 @@
+#include "tree.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <variant>
+
+#include "visitors.h"
+
+namespace {
+
+/// @brief the pointer-linked layout the flat tree replaced, one heap
+/// allocation per node
+namespace linked {
+
+struct BinaryExpr;
+struct UnaryExpr;
+
+using node_t = std::variant<BinaryExpr, UnaryExpr, Term>;
+
+struct BinaryExpr {
+  Token::Kind             oper;
+  std::unique_ptr<node_t> left;
+  std::unique_ptr<node_t> right;
+};
+
+struct UnaryExpr {
+  Token::Kind             oper;
+  std::unique_ptr<node_t> child;
+};
+
+/// @brief malloc bookkeeping per allocation on glibc
+constexpr std::size_t malloc_overhead{16};
+
+/// @brief "1 * X^0 + 1 * X^1 + 1 * X^2 + ... = 0"
+std::unique_ptr<node_t> equation(const std::size_t count) {
+  auto expr = std::make_unique<node_t>(Term{1, 'X', 0});
+
+  for (std::size_t i = 1; i < count; ++i) {
+    auto rhs = std::make_unique<node_t>(Term{1, 'X', static_cast<int>(i % 3)});
+    expr = std::make_unique<node_t>(
+        BinaryExpr{Token::Kind::kPlus, std::move(expr), std::move(rhs)});
+  }
+  auto zero = std::make_unique<node_t>(Term{0});
+  return std::make_unique<node_t>(
+      BinaryExpr{Token::Kind::kEqual, std::move(expr), std::move(zero)});
+}
+
+/// @brief sum of all coefficients; iterative, very long chains overflow the
+/// call stack of a recursive visitor
+double traverse(const node_t& root) {
+  std::vector<const node_t*> pending{&root};
+  double                     sum{0};
+
+  while (!pending.empty()) {
+    const node_t* node = pending.back();
+
+    pending.pop_back();
+    if (const auto* binary = std::get_if<BinaryExpr>(node)) {
+      pending.push_back(binary->right.get());
+      pending.push_back(binary->left.get());
+    } else if (const auto* unary = std::get_if<UnaryExpr>(node)) {
+      pending.push_back(unary->child.get());
+    } else {
+      sum += std::get<Term>(*node).getCoe();
+    }
+  }
+  return sum;
+}
+
+/// @brief iterative destruction, the default one recurses per node
+void release(std::unique_ptr<node_t> root) {
+  std::vector<std::unique_ptr<node_t>> pending;
+
+  pending.push_back(std::move(root));
+  while (!pending.empty()) {
+    std::unique_ptr<node_t> node = std::move(pending.back());
+
+    pending.pop_back();
+    if (auto* binary = std::get_if<BinaryExpr>(node.get())) {
+      pending.push_back(std::move(binary->left));
+      pending.push_back(std::move(binary->right));
+    }
+  }
+}
+
+}  // namespace linked
+
+/// @brief same equation as linked::equation in the flat layout
+void equation(Tree& tree, const std::size_t count) {
+  Tree::index_t expr = tree.term(Term{1, 'X', 0});
+
+  for (std::size_t i = 1; i < count; ++i) {
+    const Tree::index_t rhs = tree.term(Term{1, 'X', static_cast<int>(i % 3)});
+    expr = tree.binary(Token::Kind::kPlus, expr, rhs);
+  }
+  const Tree::index_t zero = tree.term(Term{0});
+  tree.binary(Token::Kind::kEqual, expr, zero);
+}
+
+double traverse(const Tree& tree) {
+  double sum{0};
+
+  for (const Node& node : tree.getNodes()) {
+    if (node.kind == Node::Kind::kTerm) {
+      sum += tree.getTerms()[node.left].getCoe();
+    }
+  }
+  return sum;
+}
+
+}  // namespace
+
+static void BM_linkedTreeTraversal(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  auto       root = linked::equation(count);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(linked::traverse(*root));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["bytes_per_node"] =
+      sizeof(linked::node_t) + linked::malloc_overhead;
+  linked::release(std::move(root));
+}
+BENCHMARK(BM_linkedTreeTraversal)->RangeMultiplier(10)->Range(10000, 1000000);
+
+static void BM_flatTreeTraversal(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  Tree       tree{};
+
+  equation(tree, count);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(traverse(tree));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["bytes_per_node"] =
+      static_cast<double>(tree.getNodes().size() * sizeof(Node) +
+                          tree.getTerms().size() * sizeof(Term)) /
+      static_cast<double>(tree.getNodes().size());
+}
+BENCHMARK(BM_flatTreeTraversal)->RangeMultiplier(10)->Range(10000, 1000000);
+
+static void BM_flatTreeReduction(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  Tree       tree{};
+
+  equation(tree, count);
+  for (auto _ : state) {
+    RpnVisitor rpn{};
+
+    rpn(tree);
+    benchmark::DoNotOptimize(rpn.terms);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_flatTreeReduction)->RangeMultiplier(10)->Range(10000, 1000000);
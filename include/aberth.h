@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace utils {
+
+/// @brief when polynomial_roots stops iterating. A root is done when its
+/// last step was at most tolerance relative to its magnitude, or when the
+/// polynomial evaluates to within its own rounding error there.
+struct Convergence {
+  double      tolerance{4 * std::numeric_limits<double>::epsilon()};
+  unsigned    max_iterations{1000};
+  std::size_t parallel_degree{512};  // split iterations across threads from
+  unsigned    threads{0};            // 0 for one per hardware thread
+};
+
+/// @brief of the polynomials the interpreter solves: polynomial_roots takes
+/// time quadratic in the degree and memory linear in it
+inline constexpr int max_solved_degree{4096};
+
+/// @brief every complex root of a polynomial, real and imaginary parts
+/// stored apart; roots of multiplicity m appear m times. error[i] is the
+/// radius of a disc around root i that holds an exact root: near eps
+/// relative to the root where it is simple, near eps^(1/m) at a root of
+/// multiplicity m.
+struct PolynomialRoots {
+  std::vector<double> real;
+  std::vector<double> imag;
+  std::vector<double> error;
+  unsigned            iterations;
+  bool                converged;
+};
+
+PolynomialRoots polynomial_roots(const std::vector<double> &coefficients,
+                                 const Convergence &convergence = {});
+
+}  // namespace utils
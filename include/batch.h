@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "cache.h"
+#include "interpreter.h"
+#include "parser.h"
+#include "pool.h"
+#include "writer.h"
+
+namespace batch {
+
+/// @brief read-only memory mapping of a whole file
+class MappedFile {
+ public:
+  MappedFile(const std::string &path);
+  ~MappedFile();
+
+  std::string_view view() const;
+
+ private:
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  void       *data;
+  std::size_t size;
+};
+
+/// @brief entries of the solution cache of a batch run
+constexpr std::size_t cache_entries{1 << 14};
+
+std::string_view nextLine(std::string_view &input);
+void record(const std::size_t number, std::string_view line, std::ostream &os);
+void record(const std::size_t number, std::string_view line, Writer &out);
+void record(const std::size_t number, std::string_view line, std::ostream &os,
+            SolutionCache &cache);
+void record(const std::size_t number, std::string_view line, Writer &out,
+            SolutionCache &cache);
+void run(std::string_view input, std::ostream &os);
+void run(std::string_view input, std::ostream &os, SolutionCache &cache);
+void run(std::string_view input, std::ostream &os, const unsigned jobs);
+void run(std::string_view input, std::ostream &os, const unsigned jobs,
+         SolutionCache &cache);
+
+}  // namespace batch
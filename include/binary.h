@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// @brief binary coefficient input, for callers that already hold reduced
+/// forms as numbers. Every field is little-endian:
+///
+///   header, 16 bytes
+///     0  char[4]  magic "CV1B"
+///     4  u16      version, 1
+///     6  u16      max degree D
+///     8  u64      number of records
+///   record, 8 + 8 * (D + 1) bytes each
+///     0  u8       degree d <= D; coefficients above d are ignored
+///     1  char     variable, 'A' to 'Z'
+///     2  u8[6]    reserved, zero
+///     8  f64[D+1] coefficients of X^0 to X^D
+///
+/// Each record is the reduced form c0 + c1 * X + ... + cd * X^d = 0 and
+/// gets one batch record ("<n>: <solutions>"), without lexing or parsing.
+namespace binary {
+
+constexpr std::string_view magic{"CV1B"};
+constexpr std::uint16_t    version{1};
+constexpr std::size_t      header_size{16};
+constexpr std::size_t      record_header_size{8};
+
+/// @brief records solved together by the vectorised quadratic solver
+constexpr std::size_t chunk_records{1024};
+
+struct Header {
+  std::uint16_t version;
+  std::uint16_t max_degree;
+  std::uint64_t count;
+};
+
+std::size_t recordSize(const unsigned max_degree);
+Header      header(std::string_view input);
+void        run(std::string_view input, std::ostream &os);
+
+void appendHeader(std::string &output, const unsigned max_degree,
+                  const std::uint64_t count);
+void appendRecord(std::string &output, const unsigned max_degree,
+                  const char var, const std::vector<double> &coefficients);
+
+}  // namespace binary
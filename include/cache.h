@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "utils.h"
+
+class DiskCache;
+
+/// @brief thread-safe, size-bounded LRU cache of solutions, keyed by the
+/// coefficients of the reduced form scaled by a power of two, so a hit
+/// returns bit for bit what solving would. Equations that only differ by
+/// the name of their variable, or by a power of two factor, share an entry.
+/// Misses fall through to an optional DiskCache shared with other processes.
+class SolutionCache {
+ public:
+  using solutions_t = std::vector<std::variant<double, utils::Complex>>;
+
+  /// @brief a * x^2 + b * x + c, of degree 1 when a is 0
+  struct Key {
+    double a;
+    double b;
+    double c;
+
+    bool operator==(const Key &other) const;
+  };
+
+  /// @brief canonical hash of a key, stable across processes
+  struct Hash {
+    std::size_t operator()(const Key &key) const;
+  };
+
+  SolutionCache(const std::size_t capacity);
+  SolutionCache(const std::size_t capacity, DiskCache &disk);
+
+  std::optional<solutions_t> find(const Key &key);
+  bool                       find(const Key &key, solutions_t &solutions);
+  void                       insert(const Key &key, solutions_t solutions);
+  std::size_t                size() const;
+  std::size_t                capacity() const;
+  std::size_t                hits() const;
+  std::size_t                misses() const;
+  std::size_t                diskHits() const;
+
+  static Key         key(const double a, const double b, const double c);
+  static solutions_t solve(const Key &key);
+
+ private:
+  using entry_t = std::pair<Key, solutions_t>;
+
+  SolutionCache(const SolutionCache &) = delete;
+  SolutionCache &operator=(const SolutionCache &) = delete;
+
+  void store(const Key &key, solutions_t solutions);
+
+  mutable std::mutex                                          mutex;
+  std::list<entry_t>                                          entries;
+  std::unordered_map<Key, std::list<entry_t>::iterator, Hash> index;
+  std::size_t                                                 limit;
+  DiskCache                                                  *disk;
+  std::atomic<std::size_t>                                    hit;
+  std::atomic<std::size_t>                                    miss;
+  std::atomic<std::size_t>                                    disk_hit;
+};
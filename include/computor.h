@@ -0,0 +1,513 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include "exceptions.h"
+#include "numeric.h"
+#include "term.h"
+#include "token.h"
+#include "utils.h"
+
+/// @brief constexpr lexing, parsing, reduction and solving of an equation
+/// written as a literal:
+///
+///   constexpr auto solution = computor::solve("1 * X^2 - 4 * X^0 = 0");
+///
+/// Accepts a subset of the runtime grammar: terms of the subject's form
+/// with single-letter variables, and no parentheses. Multi-letter
+/// identifiers and groups fail to compile. Terms are reduced in the order of
+/// Parser::reduce and quadratics solved with the compensated discriminant,
+/// so the solutions are the ones the runtime prints. A quadratic whose
+/// discriminant the runtime cannot trust, and solves again in higher
+/// precision, throws instead. An invalid literal throws too, which in a
+/// constant expression fails to compile. Limited to degree 2, max_terms distinct
+/// terms, and numbers that are exact at double precision before scaling (at
+/// most 2^53 without their decimal point and trailing zeros, and a scale of
+/// at most 10^22).
+namespace computor {
+
+/// @brief distinct variable and exponent pairs a reduced form may hold
+constexpr std::size_t max_terms{32};
+
+struct Solution {
+  using solution_t = std::variant<double, utils::Complex>;
+
+  int                       degree;
+  bool                      all_reals;  // every term cancelled out
+  std::size_t               count;
+  std::array<solution_t, 2> solutions;
+};
+
+namespace detail {
+
+/// @brief the part of a Token the parser looks at, without the variant
+struct Lexeme {
+  Token::Kind kind;
+  double      number;
+  char        var;
+  std::size_t offset;
+};
+
+/// @brief constexpr counterpart of Lexer
+class Scanner {
+ public:
+  constexpr Scanner(std::string_view s)
+      : input{s}, position{0}, buffer{}, full{false} {}
+
+  constexpr Lexeme peek() {
+    if (!full) {
+      buffer = get();
+      full = true;
+    }
+    return buffer;
+  }
+
+  constexpr Lexeme advance() {
+    const Lexeme lexeme = peek();
+
+    full = false;
+    return lexeme;
+  }
+
+ private:
+  static constexpr bool isDigit(const char ch) {
+    return ch >= '0' && ch <= '9';
+  }
+
+  static constexpr bool isAlpha(const char ch) {
+    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+  }
+
+  /// @brief "<int>", "<int>." or "<int>.<int>", rounded like std::from_chars:
+  /// the digits and the power of ten are both exact, so the one
+  /// multiplication or division between them rounds correctly
+  constexpr Lexeme number() {
+    constexpr std::uint64_t max_mantissa{std::uint64_t{1} << 53};
+    constexpr int           max_scale{22};
+
+    const std::size_t start{position};
+    std::size_t       last_nonzero{0};
+    std::size_t       digits{0};
+    std::size_t       fraction{0};
+    bool              point{false};
+
+    for (; position < input.size(); ++position) {
+      const char ch = input[position];
+
+      if (isDigit(ch)) {
+        ++digits;
+        fraction += point;
+        if (ch != '0') {
+          last_nonzero = digits;
+        }
+      } else if (ch == '.' && !point) {
+        point = true;
+      } else {
+        break;
+      }
+    }
+    std::uint64_t mantissa{0};
+    std::size_t   seen{0};
+
+    for (std::size_t i = start; i < position && seen < last_nonzero; ++i) {
+      if (isDigit(input[i])) {
+        mantissa = mantissa * 10 + static_cast<std::uint64_t>(input[i] - '0');
+        ++seen;
+        if (mantissa > max_mantissa) {
+          throw grammarError(
+              "number has too many digits for constant evaluation", start);
+        }
+      }
+    }
+    const int scale = static_cast<int>(digits - last_nonzero) -
+                      static_cast<int>(fraction);
+
+    if (scale > max_scale || -scale > max_scale) {
+      throw grammarError("number is too large or too small for constant "
+                         "evaluation",
+                         start);
+    }
+    double power{1};
+
+    for (int i = 0; i < (scale < 0 ? -scale : scale); ++i) {
+      power *= 10;
+    }
+    const double value = last_nonzero ? (scale < 0 ? mantissa / power
+                                                   : mantissa * power)
+                                      : 0.0;
+    return Lexeme{Token::Kind::kNumber, value, 0, start};
+  }
+
+  constexpr Lexeme get() {
+    while (position < input.size()) {
+      const std::size_t start{position};
+      const char        ch = input[position];
+
+      switch (ch) {
+        case ' ':
+          ++position;
+          continue;
+        case 'q':
+        case '+':
+        case '-':
+        case '*':
+        case '/':
+        case '^':
+        case '=':
+          ++position;
+          return Lexeme{Token::Kind{ch}, 0, ch, start};
+        default:
+          if (isDigit(ch)) {
+            return number();
+          } else if (isAlpha(ch)) {
+            ++position;
+            return Lexeme{Token::Kind::kVariable, 0, ch, start};
+          }
+          throw grammarError(
+              std::string{"character not supported: "} + std::string{ch},
+              start);
+      }
+    }
+    return Lexeme{Token::Kind::kEnd, 0, 0, position};
+  }
+
+  std::string_view input;
+  std::size_t      position;
+  Lexeme           buffer;
+  bool             full;
+};
+
+/// @brief constexpr counterpart of Polynomial, unordered
+class Terms {
+ public:
+  constexpr Terms() : terms{}, size{0} {}
+
+  /// @brief add a term to the coefficient of its like terms, in the order
+  /// RpnVisitor::addTerm would, so the sums round the same
+  constexpr void add(const Term &term) {
+    if (!term.getCoe()) {
+      return;
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+      if (likeTerms(terms[i], term)) {
+        terms[i].setCoe(terms[i].getCoe() + term.getCoe());
+        return;
+      }
+    }
+    if (size == max_terms) {
+      throw std::invalid_argument(
+          "too many distinct terms for constant evaluation");
+    }
+    terms[size++] = term;
+  }
+
+  constexpr double find(const char var, const int exp) const {
+    for (std::size_t i = 0; i < size; ++i) {
+      if (terms[i].getVar() == var && terms[i].getExp() == exp) {
+        return terms[i].getCoe();
+      }
+    }
+    return 0;
+  }
+
+  constexpr bool empty() const { return !count(); }
+
+  /// @brief the non-zero term that Polynomial would order last
+  constexpr Term last() const {
+    Term result{};
+
+    for (std::size_t i = 0; i < size; ++i) {
+      const Term &term = terms[i];
+
+      if (term.getCoe() &&
+          (term.getVar() > result.getVar() ||
+           (term.getVar() == result.getVar() &&
+            term.getExp() > result.getExp()))) {
+        result = term;
+      }
+    }
+    return result;
+  }
+
+  constexpr int degree() const {
+    int highest{0};
+
+    for (std::size_t i = 0; i < size; ++i) {
+      if (terms[i].getCoe() && terms[i].getExp() > highest) {
+        highest = terms[i].getExp();
+      }
+    }
+    return highest;
+  }
+
+  constexpr bool sameVars() const {
+    const Term check = last();
+
+    if (isConstant(check)) {
+      return true;
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+      if (terms[i].getCoe() && !isConstant(terms[i]) &&
+          !::sameVars(terms[i], check)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  constexpr std::size_t count() const {
+    std::size_t nonzero{0};
+
+    for (std::size_t i = 0; i < size; ++i) {
+      nonzero += terms[i].getCoe() != 0;
+    }
+    return nonzero;
+  }
+
+  std::array<Term, max_terms> terms;
+  std::size_t                 size;
+};
+
+/// @brief constexpr counterpart of Parser::reduce with its Reducer builder
+class Reducer {
+ public:
+  constexpr Reducer(std::string_view s)
+      : scanner{s}, terms{}, transposed{false} {}
+
+  constexpr Terms reduce() {
+    if (scanner.peek().kind == Token::Kind::kQuit) {
+      throw grammarError("quit is not an equation");
+    }
+    const Term lhs = equation();
+
+    if (!transposed) {
+      throw std::invalid_argument("expression is not an equation");
+    }
+    checkLimits(lhs);
+    terms.add(lhs);
+    return terms;
+  }
+
+ private:
+  static constexpr void checkLimits(const Term &term) {
+    if (term < std::numeric_limits<int>::min()) {
+      throw std::invalid_argument(
+          "number too small, the lower limit is: " +
+          std::to_string(std::numeric_limits<int>::min()) + "\n");
+    } else if (term > std::numeric_limits<int>::max()) {
+      throw std::invalid_argument(
+          "number too big, the upper limit is: " +
+          std::to_string(std::numeric_limits<int>::max()) + "\n");
+    }
+  }
+
+  constexpr bool check(const Token::Kind kind) {
+    return scanner.peek().kind == kind;
+  }
+
+  constexpr void fold(const Token::Kind oper, Term rhs) {
+    checkLimits(rhs);
+    if (oper == Token::Kind::kMinus) {
+      rhs = -rhs;
+    }
+    terms.add(rhs);
+  }
+
+  constexpr Term term() {
+    Term expr{};
+
+    if (check(Token::Kind::kNumber)) {
+      expr.setCoe(scanner.advance().number);
+    } else {
+      throw grammarError("missing number in term (ex. \"42\" * X^2)",
+                         scanner.peek().offset);
+    }
+    if (!expr.getCoe() && check(Token::Kind::kEnd)) {
+      return transpose(expr);
+    }
+    if (check(Token::Kind::kAsterisk)) {
+      scanner.advance();
+    } else {
+      throw grammarError("missing asterisk in term (ex. 42 \"*\" X^2)",
+                         scanner.peek().offset);
+    }
+    if (check(Token::Kind::kVariable)) {
+      expr.setVar(scanner.advance().var);
+    } else {
+      throw grammarError("missing variable in term (ex. 42 * \"X\"^2)",
+                         scanner.peek().offset);
+    }
+    if (check(Token::Kind::kCaret)) {
+      scanner.advance();
+    } else {
+      throw grammarError("missing caret in term (ex. 42 * X\"^\"2)",
+                         scanner.peek().offset);
+    }
+    if (check(Token::Kind::kNumber)) {
+      expr.setExp(static_cast<int>(scanner.advance().number));
+    } else {
+      throw grammarError("missing exponent in term (ex. 42 * X^\"2\")",
+                         scanner.peek().offset);
+    }
+    return transpose(expr);
+  }
+
+  /// @brief see TransposeVisitor
+  constexpr Term transpose(Term term) const {
+    if (transposed) {
+      term.setCoe(term > 0 ? -term.getCoe() : term.getCoe());
+    }
+    return term;
+  }
+
+  constexpr Term unary() {
+    if (check(Token::Kind::kMinus)) {
+      scanner.advance();
+      return -unary();
+    }
+    return term();
+  }
+
+  constexpr Term power() {
+    const Term expr = unary();
+
+    while (check(Token::Kind::kCaret)) {
+      const Token::Kind oper = scanner.advance().kind;
+      fold(oper, term());
+    }
+    return expr;
+  }
+
+  constexpr Term factor() {
+    const Term expr = power();
+
+    while (check(Token::Kind::kAsterisk) || check(Token::Kind::kSlash)) {
+      const Token::Kind oper = scanner.advance().kind;
+      fold(oper, power());
+    }
+    return expr;
+  }
+
+  constexpr Term expression() {
+    const Term expr = factor();
+
+    while (check(Token::Kind::kPlus) || check(Token::Kind::kMinus)) {
+      const Token::Kind oper = scanner.advance().kind;
+      fold(oper, factor());
+    }
+    return expr;
+  }
+
+  constexpr Term equation() {
+    const Term expr = expression();
+
+    if (check(Token::Kind::kEqual)) {
+      const Token::Kind oper = scanner.advance().kind;
+
+      transposed = true;
+      const Term rhs = expression();
+      if (!check(Token::Kind::kEnd)) {
+        throw grammarError("missing end of equation token",
+                           scanner.peek().offset);
+      }
+      fold(oper, rhs);
+    }
+    return expr;
+  }
+
+  Scanner scanner;
+  Terms   terms;
+  bool    transposed;
+};
+
+/// @brief see utils::linear_equation_solver
+constexpr double linear(const double slope, const double intercept) {
+  if (!slope) {
+    throw std::invalid_argument("'slope' can not be 0");
+  } else if (!intercept) {
+    return 0;
+  } else if (slope > 1 || slope < -1) {
+    return intercept / slope;
+  }
+  return (1 / slope) * intercept;
+}
+
+/// @brief see utils::quadratic_equation_solver. The quadratics it solves
+/// again in higher precision throw instead, so no root differs from it.
+constexpr Solution quadratic(const double a, const double b, const double c) {
+  using solution_t = Solution::solution_t;
+
+  if (!b && !c) {
+    return Solution{2, false, 1, {solution_t{0.0}, solution_t{0.0}}};
+  }
+  bool         certain{true};
+  const double discriminant{
+      numeric::constant::discriminant(a, b, c, certain)};
+
+  if (!certain) {
+    throw std::invalid_argument(
+        "discriminant too close to cancelling out for constant evaluation");
+  }
+  const double vertex{-b / (2 * a) + 0.0};
+
+  if (!discriminant) {
+    return Solution{2, false, 1, {solution_t{vertex}, solution_t{0.0}}};
+  } else if (discriminant > 0) {
+    double plus{0};
+    double minus{0};
+
+    numeric::constant::quadratic_roots(
+        a, b, c, numeric::constant::sqrt(discriminant), plus, minus);
+    return Solution{
+        2, false, 2, {solution_t{plus + 0.0}, solution_t{minus + 0.0}}};
+  }
+  const double imag{numeric::constant::sqrt(-discriminant) / (2 * a) + 0.0};
+
+  return Solution{2,
+                  false,
+                  2,
+                  {solution_t{utils::Complex{vertex, -imag}},
+                   solution_t{utils::Complex{vertex, imag}}}};
+}
+
+}  // namespace detail
+
+/// @brief reduce and solve an equation, like Interpreter::solve
+constexpr Solution solve(std::string_view equation) {
+  constexpr int max_degree{2};
+
+  const detail::Terms terms = detail::Reducer{equation}.reduce();
+
+  if (terms.empty()) {
+    return Solution{0, true, 0, {}};
+  }
+  if (!terms.sameVars()) {
+    throw std::invalid_argument(
+        "can not solve equation with different variables");
+  }
+  const int degree = terms.degree();
+
+  if (degree > max_degree) {
+    throw std::invalid_argument(
+        "constant evaluation solves equations up to degree 2");
+  }
+  const char   var = terms.last().getVar();
+  const double a = terms.find(var, 2);
+  const double b = terms.find(var, 1);
+  const double c = terms.find(var, 0);
+
+  if (a) {
+    return detail::quadratic(a, b, c);
+  }
+  return Solution{degree, false, 1, {detail::linear(b, c), 0.0}};
+}
+
+}  // namespace computor
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "cache.h"
+
+/// @brief solution cache in a memory-mapped file, shared by every process
+/// that opens the same path. The file is a fixed-size open-addressing table
+/// of one cache line per slot; readers never lock, writers claim a slot with
+/// a compare-and-swap on its sequence number (seqlock). A slot also holds a
+/// checksum of its words, which readers check: a writer that died mid-write
+/// leaves its slot claimed, and the next writer reclaims it. When the probe
+/// window of a key is full, inserting evicts one of its entries, which caps
+/// the file at its slot count without compaction. A header with the format
+/// version and utils::solver_revision guards against reading entries written
+/// by another format or solver: mismatching files are replaced by an empty
+/// table.
+class DiskCache {
+ public:
+  using Key = SolutionCache::Key;
+  using solutions_t = SolutionCache::solutions_t;
+
+  static constexpr std::uint32_t version{3};
+  static constexpr std::size_t   default_slots{1 << 16};
+
+  DiskCache(const std::string &path, const std::size_t slots);
+  ~DiskCache();
+
+  std::optional<solutions_t> find(const Key &key) const;
+  void                       insert(const Key &key, const solutions_t &solutions);
+  std::size_t                slots() const;
+
+ private:
+  struct Header {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t slot_size;
+    std::uint64_t slots;
+    std::uint32_t solver;
+    std::uint32_t unused;
+    std::uint64_t reserved[4];
+  };
+
+  /// @brief solution count and kind; a; b; c; two roots, or the real and
+  /// imaginary parts of a conjugate pair; checksum of the others
+  static constexpr std::size_t slot_words{7};
+
+  struct alignas(64) Slot {
+    std::atomic<std::uint64_t> sequence;
+    std::atomic<std::uint64_t> words[slot_words];
+  };
+
+  static_assert(sizeof(Header) == 64);
+  static_assert(sizeof(Slot) == 64);
+  static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+  DiskCache(const DiskCache &) = delete;
+  DiskCache &operator=(const DiskCache &) = delete;
+
+  bool        map(const std::string &path);
+  static void create(const std::string &path, const std::size_t slots);
+
+  void       *data;
+  std::size_t size;
+  Slot       *table;
+  std::size_t mask;
+};
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 
 class grammarError : public std::runtime_error {
  public:
   grammarError(const std::string& error) : std::runtime_error{error.c_str()} {}
+  grammarError(const std::string& error, const std::size_t offset)
+      : std::runtime_error{error + " at column " +
+                           std::to_string(offset + 1)} {}
 };
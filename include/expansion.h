@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace utils {
+
+/// @brief how polynomial_product multiplies. kAuto picks by size: the
+/// schoolbook method below karatsuba_size coefficients, the number
+/// theoretic transform from ntt_size when the product is exact with it,
+/// Karatsuba otherwise.
+enum class Product { kAuto, kSchoolbook, kKaratsuba, kNtt };
+
+inline constexpr std::size_t karatsuba_size{64};
+inline constexpr std::size_t ntt_size{8192};
+
+/// @brief of an expanded group, which bounds the memory it takes
+inline constexpr std::size_t max_expanded_degree{std::size_t{1} << 20};
+
+bool ntt_exact(const std::vector<double> &a, const std::vector<double> &b);
+void polynomial_product(const std::vector<double> &a,
+                        const std::vector<double> &b,
+                        std::vector<double>       &product,
+                        const Product              algorithm = Product::kAuto);
+void polynomial_power(const std::vector<double> &base, unsigned exponent,
+                      std::vector<double> &power);
+
+}  // namespace utils
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "polynomial.h"
+#include "parser.h"
+#include "visitors.h"
+
+/// @brief reduces a sequence of equations that are mostly small edits of
+/// each other, as typed into the REPL. An equation is split into the
+/// operands of its "+", "-" and "=", and the terms each one folds are kept
+/// in the order reduce folds them. When an edit stays within one operand,
+/// only that operand is lexed and parsed again, and only the coefficients
+/// of its old and new terms are summed again, in the same order, so the
+/// reduced form is bit for bit what a full reduction gives. Any other edit
+/// splits and reduces the whole equation again.
+class Incremental {
+ public:
+  Incremental();
+
+  bool                reduce(std::string_view equation);
+  const Polynomial   &reduced() const;
+  bool                reused() const;
+  void                clear();
+
+ private:
+  Incremental(const Incremental &) = delete;
+  Incremental &operator=(const Incremental &) = delete;
+
+  /// @brief an operand: its span in the line, from after the operator
+  /// before it to the next one, and its terms in folds
+  struct Operand {
+    std::size_t begin;
+    std::size_t end;
+    std::size_t first;
+    std::size_t count;
+    Token::Kind oper;
+    bool        transposed;
+  };
+
+  bool rebuild(std::string_view equation);
+  bool update(std::string_view equation);
+  bool parse(const Operand &operand, std::string_view text, const bool last);
+  void sum();
+  void resum();
+
+  template <typename F>
+  void forEachInOrder(F &&f) const;
+
+  Parser                         par;
+  RpnVisitor                     rpn;
+  std::string                    line;
+  std::vector<Operand>           operands;
+  std::vector<Term>              folds;    // every operand's, value last
+  std::vector<Term>              scratch;  // the terms of a parsed operand
+  std::vector<Polynomial::key_t> keys;     // coefficients to sum again
+  std::vector<double>            sums;
+  bool                           valid;
+  bool                           incremental;
+};
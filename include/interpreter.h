@@ -4,30 +4,57 @@
 #include <stdexcept>
 #include <variant>
 
+#include "aberth.h"
+#include "cache.h"
 #include "exceptions.h"
 #include "parser.h"
+#include "status.h"
 #include "utils.h"
 #include "visitors.h"
 
+class Writer;
+
 class Interpreter {
  public:
-  using node_t = std::variant<BinaryExpr, UnaryExpr, Term>;
   using solutions_t = std::vector<std::variant<double, utils::Complex>>;
 
+  Interpreter();
   Interpreter(Tree& t);
 
-  solutions_t getSolutions() const;
-  char        findVar() const;
-  double      findCoef(const char var, const int exp) const;
-  void        transpose();
-  void        evaluate();
+  const solutions_t& getSolutions() const;
+  char               findVar() const;
+  double             findCoef(const char var, const int exp) const;
+  bool               allReals() const;
+  void               clear();
+  void               reset(Tree& t);
+  void               load(const char var, const double* coefficients,
+                           const std::size_t count);
+  void               load(const Polynomial& reduced);
+  void               setConvergence(const utils::Convergence& c);
+  void               transpose();
+  void               reduce();
+  bool               reduce(Parser& par);
+  bool               reduce(Parser& par, Status& status);
+  void               solve();
+  void               solve(Status& status);
+  void               solve(SolutionCache& cache);
+  void               solve(SolutionCache& cache, Status& status);
+  void               evaluate();
+  void               evaluate(SolutionCache& cache);
+  void               evaluateReduced();
+  void               evaluateReduced(SolutionCache& cache);
 
  private:
-  Interpreter() = delete;
   Interpreter(const Interpreter&) = delete;
   Interpreter& operator=(const Interpreter&) = delete;
 
-  solutions_t solutions;
-  RpnVisitor  rpn;
-  Tree        tree;
+  bool describe(Writer& out);
+  void solveReduced(Status& status);
+  void solvePolynomial(const char var, const int degree, Status& status);
+  void printSolutions(Writer& out) const;
+
+  solutions_t        solutions;
+  utils::Convergence convergence;
+  RpnVisitor         rpn;
+  Tree               tree;
 };
@@ -1,30 +1,39 @@
 #pragma once
 
-#include <sstream>
 #include <stdexcept>
+#include <string_view>
 
 #include "exceptions.h"
+#include "status.h"
 #include "token.h"
 
+/// @brief splits an input into tokens without copying it. The input is only
+/// viewed: it must outlive the lexer, or the next call to stream(). Given a
+/// Status, get and peek report errors there instead of throwing.
 class Lexer {
  public:
   Lexer();
-  Lexer(const std::string &s);
+  Lexer(std::string_view s);
 
   Token get(void);
+  Token get(Status &status);
   Token peek(void);
+  Token peek(Status &status);
   void  putback(Token);
-  void  stream(const std::string &);
+  void  stream(std::string_view);
   bool  isReady() const;
+  bool  groupAhead() const;
 
  private:
   Lexer(const Lexer &) = delete;
   Lexer &operator=(const Lexer &) = delete;
 
-  Token number(void);
+  Token number(Status &status);
+  Token identifier(Status &status);
 
-  std::istringstream scanner;
-  Token              buffer;
-  bool               ready;
-  bool               full;
+  std::string_view input;
+  std::size_t      position;
+  Token            buffer;
+  bool             ready;
+  bool             full;
 };
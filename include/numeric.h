@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cmath>
+#include <stdexcept>
+
+/// @brief numeric kernels on the solving hot path. Everything is inline so
+/// the solvers compile down to a handful of instructions.
+namespace numeric {
+
+/// @brief b raised to the power of n by repeated squaring, O(log n)
+/// multiplications; usable in constant expressions
+constexpr double power(double b, unsigned n) {
+  double result{1};
+
+  while (n) {
+    if (n & 1u) {
+      result *= b;
+    }
+    b *= b;
+    n >>= 1u;
+  }
+  return result;
+}
+
+/// @brief correctly rounded square root, a single instruction on every
+/// target we build for
+inline double sqrt(const double num) { return std::sqrt(num); }
+
+/// @brief b * b - 4 * a * c without catastrophic cancellation. When the two
+/// products nearly cancel, their rounding errors are recovered with fma and
+/// added back (Kahan).
+inline double discriminant(const double a, const double b, const double c) {
+  const double p = b * b;
+  const double q = 4 * a * c;
+  const double d = p - q;
+
+  if (p + q <= 3 * std::abs(d)) {
+    return d;
+  }
+  return d + (std::fma(b, b, -p) - std::fma(4 * a, c, -q));
+}
+
+/// @brief the same, and whether it is certain: the products neither
+/// overflow nor lose bits to underflow, and where they cancel the
+/// correction outweighs its own rounding, so the result is within 2 ulps.
+/// precision::escalate settles the others.
+inline double discriminant(const double a, const double b, const double c,
+                           bool &certain) {
+  const double p = b * b;
+  const double q = 4 * a * c;
+  const double d = p - q;
+  const double scale = p + std::abs(q);
+
+  certain = (scale < 0x1p996 && scale > 0x1p-900) || (!b && !c);
+  if (p + q <= 3 * std::abs(d)) {
+    return d;
+  }
+  const double error = std::fma(b, b, -p) - std::fma(4 * a, c, -q);
+  const double result = d + error;
+
+  certain = certain && std::abs(result) >= std::abs(error);
+  return result;
+}
+
+/// @brief real roots of a * x^2 + b * x + c for a positive discriminant.
+/// Computes the root where -b and the square root have the same sign first
+/// and derives the other from the product of the roots (c / a), so neither
+/// suffers from cancellation.
+/// @param root the square root of the discriminant
+/// @param plus receives (-b + root) / 2a
+/// @param minus receives (-b - root) / 2a
+inline void quadratic_roots(const double a, const double b, const double c,
+                            const double root, double &plus, double &minus) {
+  const double q = -0.5 * (b + std::copysign(root, b));
+
+  plus = std::signbit(b) ? q / a : c / q;
+  minus = std::signbit(b) ? c / q : q / a;
+}
+
+/// @brief constant evaluation counterparts of the kernels above, built from
+/// plain arithmetic only. Evaluated as constants they give the same results
+/// bit for bit; at runtime the compiler may contract them into fma, so call
+/// the kernels above there instead.
+namespace constant {
+
+constexpr double abs(const double x) { return x < 0 ? -x : x; }
+
+/// @brief the rounding error of a * b, what std::fma(a, b, -(a * b))
+/// returns, by Dekker's product with Veltkamp's split. Exact unless a * b
+/// overflows or its error underflows.
+constexpr double product_error(const double a, const double b) {
+  constexpr double split{134217729.0};  // 2^27 + 1
+
+  const double a_split = split * a;
+  const double a_high = a_split - (a_split - a);
+  const double a_low = a - a_high;
+  const double b_split = split * b;
+  const double b_high = b_split - (b_split - b);
+  const double b_low = b - b_high;
+  const double p = a * b;
+
+  return ((a_high * b_high - p) + a_high * b_low + a_low * b_high) +
+         a_low * b_low;
+}
+
+/// @brief correctly rounded square root of a positive finite number. x is
+/// scaled into [1, 4) by powers of 4, Newton's iteration gets within an ulp
+/// and a last step on the exact residual x - y * y rounds correctly.
+constexpr double sqrt(double x) {
+  if (!(x > 0)) {
+    if (!x) {
+      return x;
+    }
+    throw std::invalid_argument(
+        "square root of negative number is not defined");
+  }
+  double scale{1};
+
+  while (x >= 4) {
+    x /= 4;
+    scale *= 2;
+  }
+  while (x < 1) {
+    x *= 4;
+    scale /= 2;
+  }
+  double y{(1 + x) / 2};
+
+  for (int i = 0; i < 6; ++i) {
+    y = (y + x / y) / 2;
+  }
+  const double square = y * y;
+  const double residual = (x - square) - product_error(y, y);
+
+  return (y + residual / (2 * y)) * scale;
+}
+
+/// @brief see numeric::discriminant
+constexpr double discriminant(const double a, const double b, const double c) {
+  const double p = b * b;
+  const double q = 4 * a * c;
+  const double d = p - q;
+
+  if (p + q <= 3 * abs(d)) {
+    return d;
+  }
+  return d + (product_error(b, b) - product_error(4 * a, c));
+}
+
+/// @brief see numeric::discriminant with certain
+constexpr double discriminant(const double a, const double b, const double c,
+                              bool &certain) {
+  const double p = b * b;
+  const double q = 4 * a * c;
+  const double d = p - q;
+  const double scale = p + abs(q);
+
+  certain = (scale < 0x1p996 && scale > 0x1p-900) || (!b && !c);
+  if (p + q <= 3 * abs(d)) {
+    return d;
+  }
+  const double error = product_error(b, b) - product_error(4 * a, c);
+  const double result = d + error;
+
+  certain = certain && abs(result) >= abs(error);
+  return result;
+}
+
+/// @brief see numeric::quadratic_roots; b must not be -0.0, which reduced
+/// forms never hold
+constexpr void quadratic_roots(const double a, const double b, const double c,
+                               const double root, double &plus,
+                               double &minus) {
+  const double q = -0.5 * (b + (b < 0 ? -root : root));
+
+  plus = b < 0 ? q / a : c / q;
+  minus = b < 0 ? c / q : q / a;
+}
+
+}  // namespace constant
+
+}  // namespace numeric
@@ -1,25 +1,45 @@
 #pragma once
 
+#include <vector>
+
 #include "lexer.h"
 #include "term.h"
 #include "tree.h"
 #include "utils.h"
 #include "visitors.h"
 
+struct RpnVisitor;
+
 class Parser {
  public:
-  using node_t = Tree::node_t;
+  using index_t = Tree::index_t;
+
   Parser();
-  Parser(const std::string &s);
+  Parser(std::string_view s);
 
-  void                      stream(const std::string &s);
+  void                      stream(std::string_view s);
   bool                      parse();
+  bool                      parse(Status &status);
+  bool                      reduce(RpnVisitor &rpn);
+  bool                      reduce(RpnVisitor &rpn, Status &status);
+  bool                      operand(RpnVisitor &rpn, const bool transposed,
+                                    std::vector<Term> &folds, Term &value,
+                                    Status &status);
   [[nodiscard]] Tree       &getTree();
   [[nodiscard]] std::string prompt();
+  bool                      prompt(std::string &equation);
 
  private:
-  Lexer lexer;
-  Tree  tree;
+  /// @brief a parenthesized operand multiplied out: a polynomial of one
+  /// variable, 0 while it is a constant, ascending by exponent
+  struct Expansion {
+    char                var;
+    std::vector<double> coefficients;
+  };
+
+  Lexer  lexer;
+  Tree   tree;
+  Status status;  // first error of the current parse
 
   Parser(const Parser &) = delete;
   Parser &operator=(const Parser &) = delete;
@@ -27,10 +47,31 @@ class Parser {
   Token               advance();
   [[nodiscard]] bool  check(const Token &token, Token::Kind kind);
   [[nodiscard]] Token peek();
-  [[nodiscard]] std::unique_ptr<node_t> term();
-  [[nodiscard]] std::unique_ptr<node_t> unary();
-  [[nodiscard]] std::unique_ptr<node_t> factor();
-  [[nodiscard]] std::unique_ptr<node_t> power();
-  [[nodiscard]] std::unique_ptr<node_t> expression();
-  [[nodiscard]] std::unique_ptr<node_t> equation();
+  void                fail(Errc code, std::size_t offset);
+  bool                unite(Expansion &lhs, const Expansion &rhs,
+                            std::size_t offset);
+  bool                divide(Expansion &lhs, const Expansion &rhs,
+                             std::size_t offset);
+  void                primary(Expansion &out);
+  void                exponentiation(Expansion &out);
+  void                negation(Expansion &out);
+  void                product(Expansion &out);
+  void                sum(Expansion &out);
+
+  template <typename Builder>
+  [[nodiscard]] typename Builder::value_t term(Builder &builder);
+  template <typename Builder>
+  [[nodiscard]] typename Builder::value_t unary(Builder &builder);
+  template <typename Builder>
+  [[nodiscard]] typename Builder::value_t expanded(Builder    &builder,
+                                                   Token::Kind oper);
+  template <typename Builder>
+  [[nodiscard]] typename Builder::value_t factor(Builder    &builder,
+                                                 Token::Kind oper);
+  template <typename Builder>
+  [[nodiscard]] typename Builder::value_t power(Builder &builder);
+  template <typename Builder>
+  [[nodiscard]] typename Builder::value_t expression(Builder &builder);
+  template <typename Builder>
+  typename Builder::value_t equation(Builder &builder);
 };
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "term.h"
+
+/// @brief the reduced form of an equation: a sparse polynomial for each
+/// variable it names. Terms are of a single variable, as the grammar has no
+/// products of variables, so a monomial is keyed by its variable and a
+/// 32-bit exponent packed into 64 bits, and X^0 and Y^0 stay apart like the
+/// terms of the equation. Coefficients are kept in one open-addressing
+/// table; those that cancel out to zero are absent.
+class Polynomial {
+ public:
+  using monomial_t = std::uint64_t;
+  using key_t = std::pair<char, int>;
+
+  Polynomial();
+
+  void        add(const Term &term);
+  void        set(const Term &term);
+  double      find(const char var, const int exp) const;
+  bool        empty() const;
+  std::size_t size() const;
+  void        clear();
+
+  /// @brief call f with every non-zero term, ordered by variable name and
+  /// exponent
+  template <typename F>
+  void forEach(F &&f) const {
+    sort();
+    for (const std::uint32_t index : order) {
+      const Entry &entry = table[index];
+
+      if (entry.coe) {
+        f(term(entry.monomial, entry.coe));
+      }
+    }
+  }
+
+ private:
+  struct Entry {
+    monomial_t monomial;
+    double     coe;
+  };
+
+  static constexpr monomial_t  empty_key{~monomial_t{0}};
+  static constexpr std::size_t initial_capacity{16};
+
+  static monomial_t pack(const char var, const int exp);
+  static key_t      unpack(const monomial_t monomial);
+  static Term       term(const monomial_t monomial, const double coe);
+  std::size_t       probe(const monomial_t monomial) const;
+  void              grow();
+  void              sort() const;
+
+  std::vector<Entry>                 table;
+  unsigned                           shift;  // 64 - log2 of the capacity
+  mutable std::vector<std::uint32_t> order;  // used entries, sorted lazily
+  mutable bool                       sorted;
+  std::size_t                        nonzero;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief fixed size thread pool where idle workers steal queued tasks from
+/// busy ones. Tasks must not throw.
+class ThreadPool {
+ public:
+  using task_t = std::function<void()>;
+
+  ThreadPool(const unsigned threads);
+  ~ThreadPool();
+
+  void     submit(task_t task);
+  unsigned size() const;
+
+  static bool onWorker();
+
+ private:
+  struct Queue {
+    std::mutex         mutex;
+    std::deque<task_t> tasks;
+  };
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  void work(const unsigned index);
+  bool pop(const unsigned index, task_t &task);
+  bool steal(const unsigned index, task_t &task);
+
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread>            workers;
+  std::mutex                          mutex;
+  std::condition_variable             available;
+  std::atomic<std::size_t>            pending;
+  std::atomic<unsigned>               next;
+  bool                                stopping;
+};
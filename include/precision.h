@@ -0,0 +1,31 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "quadratic.h"
+#include "stats.h"
+
+/// @brief adaptive precision for quadratics. The solvers work in double and
+/// check a cheap error bound on the discriminant (see numeric.h); only the
+/// doubtful ones are solved again, in double-double arithmetic, then
+/// exactly where even that could lose bits.
+namespace precision {
+
+enum class Tier : std::uint8_t { kDouble, kDoubleDouble, kExact };
+
+/// @brief count n quadratics settled by a tier, for --stats
+inline void count(const Tier tier, const std::uint64_t n = 1) {
+  constexpr std::array<stats::Counter, 3> counters{
+      stats::Counter::kDoubleSolves, stats::Counter::kDoubleDoubleSolves,
+      stats::Counter::kExactSolves};
+
+  if (stats::enabled()) {
+    stats::count(counters[static_cast<std::size_t>(tier)], n);
+  }
+}
+
+Tier escalate(double a, double b, double c, double &root1, double &root2,
+              double &imag, utils::Roots &kind);
+
+}  // namespace precision
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace utils {
+
+/// @brief what a batch-solved quadratic turned out to have
+enum class Roots : std::uint8_t {
+  kNone = 0,  // 'a' is 0, not a quadratic
+  kDouble,    // one real root, root1 == root2
+  kReal,      // two real roots
+  kComplex    // root1 - imag * i and root2 + imag * i, root1 == root2
+};
+
+void quadratic_batch_solver(const double *a, const double *b, const double *c,
+                            const std::size_t n, double *root1, double *root2,
+                            double *imag, Roots *kind);
+
+}  // namespace utils
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "cache.h"
+#include "incremental.h"
+#include "interpreter.h"
+#include "parser.h"
+
+/// @brief interactive loop evaluating one equation per line until 'q' or the
+/// end of the input. The lexer, parser, tree, reduced form and line buffer
+/// are cleared and reused between lines instead of being reallocated. By
+/// default a line is reduced incrementally from the previous one (see
+/// Incremental), and only invalid lines go through the parser and tree.
+class Repl {
+ public:
+  Repl();
+  Repl(SolutionCache &c);
+
+  void run();
+  bool step(std::string_view equation);
+  void setIncremental(const bool on);
+
+ private:
+  Repl(const Repl &) = delete;
+  Repl &operator=(const Repl &) = delete;
+
+  Parser         par;
+  Interpreter    interp;
+  Incremental    edits;
+  std::string    line;
+  SolutionCache *cache;
+  bool           incremental;
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "cache.h"
+#include "pool.h"
+
+namespace server {
+
+/// @brief requests queued or being solved per worker before the server
+/// answers new ones with "busy"
+constexpr std::size_t requests_per_worker{256};
+
+/// @brief longest request line a client may send
+constexpr std::size_t max_line{1 << 20};
+
+/// @brief Unix socket server solving newline-delimited equations. An epoll
+/// loop owns every socket and hands lines to a pool of workers; replies are
+/// batch records ("<n>: <solutions>" or "<n>: error: <message>") numbered
+/// per connection, and may arrive out of order when a client pipelines.
+class Server {
+ public:
+  Server(const std::string &path, const unsigned workers,
+         SolutionCache &cache);
+  ~Server();
+
+  void        run();
+  void        stop();
+  std::size_t rejected() const;
+
+ private:
+  struct Connection {
+    int         fd;
+    std::string input;
+    std::size_t next{1};
+    std::size_t pending{0};
+    unsigned    events{0};
+    bool        eof{false};
+    std::mutex  mutex;
+    std::string output;
+  };
+
+  using connection_t = std::shared_ptr<Connection>;
+
+  Server(const Server &) = delete;
+  Server &operator=(const Server &) = delete;
+
+  void accept();
+  void read(const connection_t &connection);
+  void request(const connection_t &connection, std::string_view line);
+  void reject(const connection_t &connection, const std::string_view reason);
+  void complete(const connection_t &connection, std::string reply);
+  void flush(const connection_t &connection);
+  void close(const connection_t &connection);
+  void watch(const int fd, const unsigned events, const int operation);
+  bool drained();
+
+  std::string                           path;
+  int                                   listener;
+  int                                   epoll;
+  int                                   wakeup;
+  SolutionCache                        &cache;
+  std::size_t                           limit;
+  std::atomic<std::size_t>              in_flight;
+  std::atomic<std::size_t>              busy;
+  std::atomic<bool>                     stopping;
+  std::unordered_map<int, connection_t> connections;
+  std::mutex                            mutex;
+  std::vector<connection_t>             ready;
+  std::unique_ptr<ThreadPool>           pool;
+};
+
+}  // namespace server
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+#include "status.h"
+
+/// @brief per-stage latency histograms and counters, printed by --stats.
+/// Built with -DCOMPUTORV1_STATS=OFF every call below compiles to nothing;
+/// otherwise an idle recorder costs one relaxed load per stage.
+namespace stats {
+
+#ifdef COMPUTORV1_STATS
+inline constexpr bool compiled{true};
+#else
+inline constexpr bool compiled{false};
+#endif
+
+using clock = std::chrono::steady_clock;
+
+enum class Stage : std::uint8_t {
+  kLex,
+  kParse,  // streaming reduction included, lexing excluded
+  kTranspose,
+  kReduce,
+  kSolve,
+  kPrint,
+  kCount
+};
+
+enum class Counter : std::uint8_t {
+  kEquations,
+  kTokens,
+  kNodes,
+  kTerms,
+  kLexErrors,
+  kGrammarErrors,
+  kReduceErrors,
+  kSolveErrors,
+  kDoubleSolves,  // quadratics by precision tier, see precision.h
+  kDoubleDoubleSolves,
+  kExactSolves,
+  kCount
+};
+
+/// @brief log-linear latency histogram: 8 buckets per power of two, so a
+/// percentile is within 12.5% of the exact value. Thread-safe.
+class Histogram {
+ public:
+  static constexpr std::size_t sub_buckets{8};
+  static constexpr std::size_t buckets{(64 - 2) * sub_buckets};
+
+  void          add(std::uint64_t ns);
+  std::uint64_t count() const;
+  std::uint64_t total() const;
+  std::uint64_t max() const;
+  std::uint64_t percentile(double p) const;
+  void          clear();
+
+  static std::size_t   bucket(std::uint64_t ns);
+  static std::uint64_t upper(std::size_t index);
+
+ private:
+  std::array<std::atomic<std::uint64_t>, buckets> counts{};
+  std::atomic<std::uint64_t>                      samples{0};
+  std::atomic<std::uint64_t>                      sum{0};
+  std::atomic<std::uint64_t>                      longest{0};
+};
+
+inline std::atomic<bool> active{false};
+
+/// @brief true while recording; constant false when compiled out
+inline bool enabled() {
+  if constexpr (compiled) {
+    return active.load(std::memory_order_relaxed);
+  }
+  return false;
+}
+
+void enable(bool on = true);
+void reset();
+void record(Stage stage, clock::duration elapsed);
+void count(Counter which, std::uint64_t n = 1);
+void countError(Errc code);
+
+/// @brief count an error by the stage that reported it
+inline void error(const Errc code) {
+  if (enabled() && code != Errc::kNone) {
+    countError(code);
+  }
+}
+
+const Histogram &histogram(Stage stage);
+std::uint64_t    counter(Counter which);
+void             report(std::ostream &os);
+
+constexpr std::size_t stages{static_cast<std::size_t>(Stage::kCount)};
+
+/// @brief time this thread spent in each stage since its Total began
+inline thread_local std::array<clock::duration, stages> laps{};
+
+/// @brief tokens this thread lexed since its Parsing began
+inline thread_local std::uint64_t tokens{0};
+
+/// @brief records the lifetime of a scope as one sample of a stage
+class Timer {
+ public:
+  explicit Timer(Stage s) : stage{s}, on{enabled()}, start{} {
+    if (on) {
+      start = clock::now();
+    }
+  }
+  ~Timer() {
+    if (on) {
+      record(stage, clock::now() - start);
+    }
+  }
+
+  Timer(const Timer &) = delete;
+  Timer &operator=(const Timer &) = delete;
+
+ private:
+  Stage             stage;
+  bool              on;
+  clock::time_point start;
+};
+
+/// @brief adds the lifetime of a scope to the enclosing Total of its stage,
+/// for stages that run in several pieces
+class Lap {
+ public:
+  explicit Lap(Stage s) : stage{s}, on{enabled()}, start{} {
+    if (on) {
+      start = clock::now();
+    }
+  }
+  ~Lap() {
+    if (on) {
+      laps[static_cast<std::size_t>(stage)] += clock::now() - start;
+    }
+  }
+
+  Lap(const Lap &) = delete;
+  Lap &operator=(const Lap &) = delete;
+
+ private:
+  Stage             stage;
+  bool              on;
+  clock::time_point start;
+};
+
+/// @brief records the laps of a stage run within a scope as one sample, if
+/// any ran
+class Total {
+ public:
+  explicit Total(Stage s) : stage{s}, on{enabled()} {
+    if (on) {
+      laps[static_cast<std::size_t>(stage)] = {};
+    }
+  }
+  ~Total() {
+    if (on && laps[static_cast<std::size_t>(stage)] != clock::duration{}) {
+      record(stage, laps[static_cast<std::size_t>(stage)]);
+    }
+  }
+
+  Total(const Total &) = delete;
+  Total &operator=(const Total &) = delete;
+
+ private:
+  Stage stage;
+  bool  on;
+};
+
+/// @brief one token from the lexer, a lap of lexing
+class Lexing : public Lap {
+ public:
+  Lexing() : Lap{Stage::kLex} {
+    if (enabled()) {
+      tokens += 1;
+    }
+  }
+};
+
+/// @brief times one parse and splits it into a lexing and a parsing sample
+class Parsing {
+ public:
+  Parsing() : lexing{Stage::kLex}, on{enabled()}, start{} {
+    if (on) {
+      tokens = 0;
+      start = clock::now();
+    }
+  }
+  ~Parsing() {
+    if (on) {
+      const clock::duration elapsed = clock::now() - start;
+
+      record(Stage::kParse,
+             elapsed - laps[static_cast<std::size_t>(Stage::kLex)]);
+      count(Counter::kEquations);
+      count(Counter::kTokens, tokens);
+    }
+  }
+
+  Parsing(const Parsing &) = delete;
+  Parsing &operator=(const Parsing &) = delete;
+
+ private:
+  Total             lexing;
+  bool              on;
+  clock::time_point start;
+};
+
+}  // namespace stats
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+/// @brief why an equation could not be solved
+enum class Errc : std::uint8_t {
+  kNone = 0,
+  // lexing
+  kEmptyInput,
+  kUnsupportedCharacter,
+  kNumberOverflow,
+  kNumberUnderflow,
+  kInvalidNumber,
+  kTooManyIdentifiers,
+  kInvalidRecord,  // of the binary input format
+  // parsing
+  kMissingNumber,
+  kMissingAsterisk,
+  kMissingVariable,
+  kMissingCaret,
+  kMissingExponent,
+  kMissingEnd,
+  kMissingParenthesis,
+  kNotEquation,
+  kQuit,
+  // reduction
+  kUnexpectedToken,
+  kNegateZero,
+  kUnlikeVariables,
+  kIndivisible,
+  kDegreeTooBig,
+  kTooSmall,
+  kTooBig,
+  // solving
+  kNoTerms,
+  kSolveDegreeTooBig,
+  kDifferentVariables,
+  kZeroSlope,
+  kNoSolution,
+  kNoConvergence
+};
+
+/// @brief error code of the non-throwing overloads, which take a Status&
+/// like std::filesystem takes a std::error_code&. Cheap to pass around: the
+/// message is only formatted when it is written or raised.
+struct Status {
+  Errc        code{Errc::kNone};
+  std::size_t offset{0};  // of the offending token, for grammar errors
+  char        ch{0};      // the unsupported character
+
+  /// @brief true on error
+  explicit operator bool() const { return code != Errc::kNone; }
+
+  std::string       message() const;
+  [[noreturn]] void raise() const;
+};
+
+class Writer;
+
+std::ostream &operator<<(std::ostream &os, const Status &status);
+Writer       &operator<<(Writer &os, const Status &status);
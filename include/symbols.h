@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "status.h"
+
+/// @brief the variables of equations, interned per thread. A one-letter
+/// name is its own symbol, as the constexpr computor reads it; longer names
+/// get the char values from 0x80 up, in the order they are first seen since
+/// the last reset. Whatever reads equations resets before each one, so the
+/// capacity bounds the names of an equation, not of a session.
+namespace symbols {
+
+using symbol_t = char;
+
+/// @brief of the longer names
+inline constexpr std::size_t capacity{128};
+
+void             reset();
+symbol_t         intern(std::string_view name, Status &status);
+std::string_view name(const symbol_t symbol);
+
+}  // namespace symbols
@@ -1,32 +1,37 @@
 #pragma once
 
 #include <iostream>
+#include <stdexcept>
 
 #include "exceptions.h"
 
+class Writer;
+
+/// @brief a coefficient times a variable raised to an exponent. Everything
+/// but printing is constexpr, so terms can be built and folded during
+/// constant evaluation (see computor.h).
 class Term {
  public:
-  Term();
-  Term(const double c);
-  Term(const double c, const char v);
-  Term(const double c, const char v, const int e);
-
-  Term &operator=(const Term &rhs);
-  Term &operator-=(const Term &rhs);
-  Term &operator+=(const Term &rhs);
-  Term  operator-() const;
-
-  Term operator*(const Term &rhs);
-  Term operator/(const Term &rhs);
-  Term operator+(const Term &rhs);
-  Term operator-(const Term &rhs);
-
-  double getCoe() const;
-  void   setCoe(const double c);
-  char   getVar() const;
-  void   setVar(const char v);
-  int    getExp() const;
-  void   setExp(const int e);
+  constexpr Term();
+  constexpr Term(const double c);
+  constexpr Term(const double c, const char v);
+  constexpr Term(const double c, const char v, const int e);
+
+  constexpr Term &operator-=(const Term &rhs);
+  constexpr Term &operator+=(const Term &rhs);
+  constexpr Term  operator-() const;
+
+  constexpr Term operator*(const Term &rhs);
+  constexpr Term operator/(const Term &rhs);
+  constexpr Term operator+(const Term &rhs);
+  constexpr Term operator-(const Term &rhs);
+
+  constexpr double getCoe() const;
+  constexpr void   setCoe(const double c);
+  constexpr char   getVar() const;
+  constexpr void   setVar(const char v);
+  constexpr int    getExp() const;
+  constexpr void   setExp(const int e);
 
  private:
   double coe;
@@ -35,15 +40,136 @@ class Term {
 };
 
 std::ostream &operator<<(std::ostream &os, const Term &lhs);
+Writer       &operator<<(Writer &os, const Term &lhs);
+
+/* Helper functions */
+
+/// @brief check if two terms (e.g. X^2) share the same variable and exponent
+constexpr bool likeTerms(const Term &lhs, const Term &rhs) {
+  return lhs.getVar() == rhs.getVar() && lhs.getExp() == rhs.getExp();
+}
+
+constexpr bool isConstant(const Term &term) {
+  return !term.getVar() && !term.getExp();
+}
+
+constexpr bool sameVars(const Term &lhs, const Term &rhs) {
+  return lhs.getVar() == rhs.getVar();
+}
+
+constexpr bool operator<(const Term &lhs, const Term &rhs) {
+  return lhs.getVar() < rhs.getVar() || lhs.getExp() < rhs.getExp();
+}
+
+constexpr bool operator==(const Term &lhs, const Term &rhs) {
+  return lhs.getCoe() == rhs.getCoe() && lhs.getVar() == rhs.getVar() &&
+         lhs.getExp() == rhs.getExp();
+}
+
+constexpr bool operator!=(const Term &lhs, const Term &rhs) {
+  return !(lhs == rhs);
+}
+
+constexpr bool operator<(const Term &lhs, const double &rhs) {
+  return lhs.getCoe() < rhs;
+}
+
+constexpr bool operator>(const Term &lhs, const double &rhs) {
+  return lhs.getCoe() > rhs;
+}
+
+constexpr bool operator!(const Term &lhs) { return !lhs.getCoe(); }
+
+/* Term */
+
+constexpr Term::Term() : coe{0}, var{0}, exp{0} {}
+
+constexpr Term::Term(const double c) : coe{c}, var{0}, exp{0} {}
+
+constexpr Term::Term(const double c, const char v) : coe{c}, var{v}, exp{0} {
+  if (v > 'Z' || 'A' > v) {
+    throw grammarError("the variable in a term must be a capital letter");
+  }
+}
+
+constexpr Term::Term(const double c, const char v, const int e)
+    : coe{c}, var{v}, exp{e} {
+  if (v > 'Z' || 'A' > v) {
+    throw grammarError("the variable in a term must be a capital letter");
+  } else if (e < 0) {
+    throw grammarError("the exponent in a term must be positive");
+  }
+}
+
+constexpr double Term::getCoe() const { return coe; }
+
+constexpr void Term::setCoe(const double c) { coe = c; }
+
+constexpr char Term::getVar() const { return var; }
+
+constexpr void Term::setVar(const char v) { var = v; }
+
+constexpr int Term::getExp() const { return exp; }
+
+constexpr void Term::setExp(const int e) { exp = e; }
+
+constexpr Term &Term::operator-=(const Term &rhs) {
+  *this = *this - rhs;
+  return *this;
+}
+
+constexpr Term &Term::operator+=(const Term &rhs) {
+  *this = *this + rhs;
+  return *this;
+}
+
+/// @brief negate operator
+constexpr Term Term::operator-() const {
+  Term term{*this};
+
+  if (!getCoe()) {
+    throw std::runtime_error("can not negate zero");
+  }
+  term.setCoe(-getCoe());
+  return term;
+}
+
+constexpr Term Term::operator+(const Term &rhs) {
+  if (likeTerms(*this, rhs)) {
+    return Term{getCoe() + rhs.getCoe(), getVar(), getExp()};
+  }
+  throw std::runtime_error("can not add unlike terms");
+}
 
-bool likeTerms(const Term &lhs, const Term &rhs);
-bool sameVars(const Term &lhs, const Term &rhs);
-bool isConstant(const Term &lhs);
+constexpr Term Term::operator-(const Term &rhs) {
+  if (likeTerms(*this, rhs)) {
+    return Term{getCoe() - rhs.getCoe(), getVar(), getExp()};
+  }
+  throw std::runtime_error("can not subtract unlike terms");
+}
 
-bool operator<(const Term &lhs, const Term &rhs);
-bool operator==(const Term &lhs, const Term &rhs);
-bool operator!=(const Term &lhs, const Term &rhs);
+constexpr Term Term::operator*(const Term &rhs) {
+  if (isConstant(*this)) {
+    return Term{getCoe() * rhs.getCoe(), rhs.getVar(), rhs.getExp()};
+  } else if (isConstant(rhs)) {
+    return Term{getCoe() * rhs.getCoe(), getVar(), getExp()};
+  } else if (sameVars(*this, rhs)) {
+    return Term{getCoe() * rhs.getCoe(), getVar(), getExp() + rhs.getExp()};
+  }
+  throw std::runtime_error("can not factor unlike terms");
+}
 
-bool operator<(const Term &lhs, const double &rhs);
-bool operator>(const Term &lhs, const double &rhs);
-bool operator!(const Term &lhs);
+constexpr Term Term::operator/(const Term &rhs) {
+  if (!getCoe()) {
+    throw std::runtime_error("can not divide zero");
+  } else if (!rhs.getCoe()) {
+    throw std::runtime_error("can not divide by zero");
+  } else if (isConstant(*this)) {
+    return Term{getCoe() / rhs.getCoe(), rhs.getVar(), rhs.getExp()};
+  } else if (isConstant(rhs)) {
+    return Term{getCoe() / rhs.getCoe(), getVar(), getExp()};
+  } else if (sameVars(*this, rhs)) {
+    return Term{getCoe() / rhs.getCoe(), getVar(), getExp() - rhs.getExp()};
+  }
+  throw std::runtime_error("can not divide unlike terms");
+}
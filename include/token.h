@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <variant>
 
 struct Token {
@@ -15,13 +16,17 @@ struct Token {
     kSlash = '/',
     kCaret = '^',
     kEqual = '=',
+    kOpen = '(',
+    kClose = ')',
     kQuit = 'q'
   };
 
   Token();
   Token(Kind k);
   Token(Kind k, val_t v);
+  Token(Kind k, val_t v, std::size_t o);
 
-  val_t value;
-  Kind  kind;
+  val_t       value;
+  Kind        kind;
+  std::size_t offset;
 };
@@ -1,49 +1,52 @@
 #pragma once
 
-#include <memory>
-#include <variant>
+#include <cstdint>
+#include <vector>
 
 #include "term.h"
 #include "token.h"
 
 /* Nodes */
 
-struct UnaryExpr;
-struct Term;
+/// @brief a node of the flat syntax tree. Children are indices into the
+/// tree's node array; a term node refers to the tree's term payload array.
+struct Node {
+  enum class Kind : std::uint8_t { kBinary, kUnary, kTerm };
 
-struct BinaryExpr {
-  using node_t = std::variant<BinaryExpr, UnaryExpr, Term>;
-
-  BinaryExpr(Token::Kind, std::unique_ptr<node_t> &, std::unique_ptr<node_t> &);
-
-  Token::Kind             oper;
-  std::unique_ptr<node_t> left;
-  std::unique_ptr<node_t> right;
-};
-
-struct UnaryExpr {
-  using node_t = std::variant<BinaryExpr, UnaryExpr, Term>;
-
-  UnaryExpr(Token::Kind, std::unique_ptr<node_t> &);
-
-  Token::Kind             oper;
-  std::unique_ptr<node_t> child;
+  Kind          kind;
+  Token::Kind   oper;
+  std::uint32_t left;
+  std::uint32_t right;
 };
 
 /* Tree */
 
+/// @brief syntax tree stored as one contiguous node array in post-order (every
+/// subtree is a contiguous range ending at its root), plus a separate array of
+/// term payloads. clear() keeps the capacity for the next equation.
 class Tree {
  public:
-  using node_t = std::variant<BinaryExpr, UnaryExpr, Term>;
+  using index_t = std::uint32_t;
 
   Tree();
 
-  void                     setRoot(std::unique_ptr<node_t> expr);
-  std::unique_ptr<node_t> &getRoot();
+  index_t term(const Term &term);
+  index_t unary(Token::Kind oper, const index_t child);
+  index_t binary(Token::Kind oper, const index_t left, const index_t right);
+
+  const Node              &node(const index_t index) const;
+  const std::vector<Node> &getNodes() const;
+  std::vector<Term>       &getTerms();
+  const std::vector<Term> &getTerms() const;
+  index_t                  getRoot() const;
+  bool                     empty() const;
+  void                     clear();
+  void                     swap(Tree &other);
 
  private:
   Tree(const Tree &) = delete;
   Tree &operator=(const Tree &) = delete;
 
-  std::unique_ptr<node_t> root;
+  std::vector<Node> nodes;
+  std::vector<Term> terms;
 };
@@ -1,12 +1,21 @@
 #pragma once
 
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 #include <variant>
 #include <vector>
 
+class Writer;
+
 namespace utils {
 
+/// @brief revision of what linear_equation_solver and
+/// quadratic_equation_solver return, bumped with every change to their
+/// output, so solutions persisted by another revision are not served
+inline constexpr std::uint32_t solver_revision{2};
+
 struct Complex {
   double real;
   double imag;
@@ -23,7 +32,11 @@ double squareroot(const double num);
 double linear_equation_solver(const double a, const double b);
 std::vector<std::variant<double, Complex>> quadratic_equation_solver(
     const double a, const double b, const double c);
+void quadratic_equation_solver(
+    const double a, const double b, const double c,
+    std::vector<std::variant<double, Complex>>& solutions);
 
 std::ostream& operator<<(std::ostream& os, const Complex& num);
+Writer&       operator<<(Writer& os, const Complex& num);
 
 }  // namespace utils
@@ -1,39 +1,42 @@
 #pragma once
 
-#include <map>
-#include <variant>
+#include <limits>
+#include <vector>
 
 #include "parser.h"
+#include "polynomial.h"
+#include "status.h"
 #include "utils.h"
 
-struct BinaryExpr;
-struct UnaryExpr;
-struct Term;
-
 struct PrintVisitor {
   int height;
 
   PrintVisitor();
 
-  void operator()(const BinaryExpr &expr);
-  void operator()(const UnaryExpr &expr);
-  void operator()(const Term &expr);
+  void operator()(const Tree &tree, const Tree::index_t index);
 };
 
 struct TransposeVisitor {
-  void operator()(BinaryExpr &expr);
-  void operator()(UnaryExpr &expr);
-  void operator()(Term &expr);
+  void operator()(Tree &tree);
+  void operator()(Term &term);
 };
 
 struct RpnVisitor {
-  std::map<std::pair<char, int>, Term> terms;
+  Polynomial terms;
 
   RpnVisitor();
 
-  void addTerm(std::pair<std::pair<char, int>, Term> term);
-  void evaluate(const BinaryExpr &expr, Term term);
-  Term operator()(const BinaryExpr &expr);
-  Term operator()(const UnaryExpr &expr);
-  Term operator()(const Term &expr);
+  void addTerm(const Term &term);
+  Term unary(Token::Kind oper, const Term &term);
+  Term unary(Token::Kind oper, const Term &term, Status &status);
+  Term folded(Token::Kind oper, Term rhs, Status &status);
+  void fold(Token::Kind oper, Term rhs);
+  void fold(Token::Kind oper, Term rhs, Status &status);
+  Term evaluated(Token::Kind oper, Term term, Status &status);
+  void evaluate(Token::Kind oper, Term term);
+  void evaluate(Token::Kind oper, Term term, Status &status);
+  void operator()(const Tree &tree);
+
+ private:
+  std::vector<Term> stack;
 };
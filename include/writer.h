@@ -0,0 +1,82 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/// @brief buffered output sink that formats numbers with std::to_chars and
+/// writes to its stream or string in large blocks. Formatting never
+/// allocates; the buffer is flushed when full, by flush() and on
+/// destruction. Not thread-safe: give every thread its own writer.
+class Writer {
+ public:
+  /// @brief how doubles are written: like std::ostream's defaults (6
+  /// significant digits), or the shortest string that reads back exactly
+  enum class Format : std::uint8_t { kGeneral, kShortest };
+
+  static constexpr std::size_t capacity{1 << 16};
+
+  explicit Writer(std::ostream &os);
+  explicit Writer(std::string &s);
+  ~Writer();
+
+  Writer &operator<<(const char c) {
+    if (used == capacity) {
+      flush();
+    }
+    buffer[used++] = c;
+    return *this;
+  }
+
+  Writer &operator<<(const std::string_view s) {
+    if (capacity - used < s.size()) {
+      flush();
+      if (s.size() >= capacity) {
+        return write(s);
+      }
+    }
+    std::memcpy(buffer + used, s.data(), s.size());
+    used += s.size();
+    return *this;
+  }
+
+  Writer &operator<<(const char *s) { return *this << std::string_view{s}; }
+
+  Writer &operator<<(const double value);
+
+  /// @brief any integer but char, which is written as a character
+  template <typename T, typename = std::enable_if_t<std::is_integral_v<T> &&
+                                                    !std::is_same_v<T, char> &&
+                                                    !std::is_same_v<T, bool>>>
+  Writer &operator<<(const T value) {
+    constexpr std::size_t digits{24};
+
+    if (capacity - used < digits) {
+      flush();
+    }
+    used = std::to_chars(buffer + used, buffer + capacity, value).ptr - buffer;
+    return *this;
+  }
+
+  void flush();
+
+  static void   setFormat(const Format f);
+  static Format format();
+
+ private:
+  Writer(const Writer &) = delete;
+  Writer &operator=(const Writer &) = delete;
+
+  Writer &write(std::string_view s);
+
+  std::ostream *stream;
+  std::string  *string;
+  Format        style;
+  std::size_t   used;
+  char          buffer[capacity];
+};
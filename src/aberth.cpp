@@ -0,0 +1,596 @@
+#include "aberth.h"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "pool.h"
+
+#if (defined(__AVX2__) && defined(__FMA__)) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace utils {
+
+namespace {
+
+constexpr double tau{6.28318530717958647692};
+constexpr double epsilon{std::numeric_limits<double>::epsilon()};
+
+/// @brief angle between the first initial guess and the real axis, keeps
+/// the guesses off the symmetry axes of real polynomials
+constexpr double initial_angle{0.4};
+
+/// @brief tasks per pool worker for every iteration, evens out the roots
+/// that are done and cost nothing
+constexpr unsigned tasks_per_worker{4};
+
+/// @brief the roots being iterated on, real and imaginary parts apart so
+/// their pairwise interaction vectorises
+struct State {
+  std::vector<double> a;  // ascending coefficients, a[0] and a[n] non-zero
+  std::vector<double> zr;
+  std::vector<double> zi;
+  std::vector<double> wr;  // correction of this iteration, per root
+  std::vector<double> wi;
+  std::vector<char>   done;
+};
+
+/// @brief (ar + ai * i) / (br + bi * i) without overflow in the divisor
+/// (Smith)
+void divide(const double ar, const double ai, const double br,
+            const double bi, double &re, double &im) {
+  if (std::abs(br) >= std::abs(bi)) {
+    const double ratio = bi / br;
+    const double scale = br + bi * ratio;
+
+    re = (ar + ai * ratio) / scale;
+    im = (ai - ar * ratio) / scale;
+  } else {
+    const double ratio = br / bi;
+    const double scale = br * ratio + bi;
+
+    re = (ar * ratio + ai) / scale;
+    im = (ai * ratio - ar) / scale;
+  }
+}
+
+/// @brief Horner's rule for one root, see horner below
+struct Evaluation {
+  double xr;  // where p was evaluated
+  double xi;
+  bool   inside;
+  double pr;  // p(x), or the reversed p(x) outside the unit circle
+  double pi;
+  double dr;  // its derivative
+  double di;
+  double bound;  // running rounding error bound of p(x)
+};
+
+/// @brief adds 1 / (x - z[j]) for every j in [begin, end) to s
+void interactionTail(const double *zr, const double *zi, std::size_t begin,
+                     const std::size_t end, const double xr, const double xi,
+                     double &sr, double &si) {
+  for (; begin < end; ++begin) {
+    const double dr = xr - zr[begin];
+    const double di = xi - zi[begin];
+    const double inverse = 1 / (dr * dr + di * di);
+
+    sr += dr * inverse;
+    si -= di * inverse;
+  }
+}
+
+/*
+ * horner evaluates p and p' for lanes roots at once. Inside the unit circle
+ * p is evaluated at z, outside the reversed polynomial is evaluated at
+ * 1 / z instead, so high degrees do not overflow. Every root goes through
+ * the same kernel, padded groups included, so a root's correction does not
+ * depend on which roots it is grouped with.
+ */
+
+#if defined(__AVX512F__)
+
+constexpr std::size_t lanes{8};
+
+void interaction(const double *zr, const double *zi, std::size_t begin,
+                 const std::size_t end, const double xr, const double xi,
+                 double &sr, double &si) {
+  const __m512d two = _mm512_set1_pd(2);
+  const __m512d vxr = _mm512_set1_pd(xr);
+  const __m512d vxi = _mm512_set1_pd(xi);
+  __m512d       vsr = _mm512_setzero_pd();
+  __m512d       vsi = _mm512_setzero_pd();
+
+  for (; begin + lanes <= end; begin += lanes) {
+    const __m512d dr = _mm512_sub_pd(vxr, _mm512_loadu_pd(zr + begin));
+    const __m512d di = _mm512_sub_pd(vxi, _mm512_loadu_pd(zi + begin));
+    const __m512d norm = _mm512_fmadd_pd(dr, dr, _mm512_mul_pd(di, di));
+    // a 14 bit reciprocal and one Newton step: S only steers the iteration,
+    // the roots it converges to do not depend on its last bits
+    const __m512d estimate = _mm512_rcp14_pd(norm);
+    const __m512d inverse =
+        _mm512_mul_pd(estimate, _mm512_fnmadd_pd(norm, estimate, two));
+
+    vsr = _mm512_fmadd_pd(dr, inverse, vsr);
+    vsi = _mm512_fnmadd_pd(di, inverse, vsi);
+  }
+  sr += _mm512_reduce_add_pd(vsr);
+  si += _mm512_reduce_add_pd(vsi);
+  interactionTail(zr, zi, begin, end, xr, xi, sr, si);
+}
+
+void horner(const std::vector<double> &a, const double *zr, const double *zi,
+            Evaluation *out) {
+  const std::size_t n = a.size() - 1;
+  const __m512d     zero = _mm512_setzero_pd();
+  const __m512d     vzr = _mm512_loadu_pd(zr);
+  const __m512d     vzi = _mm512_loadu_pd(zi);
+  const __m512d     modulus2 =
+      _mm512_fmadd_pd(vzr, vzr, _mm512_mul_pd(vzi, vzi));
+  const __mmask8 inside =
+      _mm512_cmp_pd_mask(modulus2, _mm512_set1_pd(1), _CMP_LE_OQ);
+  const __m512d xr =
+      _mm512_mask_blend_pd(inside, _mm512_div_pd(vzr, modulus2), vzr);
+  const __m512d xi = _mm512_mask_blend_pd(
+      inside, _mm512_div_pd(_mm512_sub_pd(zero, vzi), modulus2), vzi);
+  const __m512d modulus =
+      _mm512_sqrt_pd(_mm512_fmadd_pd(xr, xr, _mm512_mul_pd(xi, xi)));
+  __m512d pr = _mm512_mask_blend_pd(inside, _mm512_set1_pd(a[0]),
+                                    _mm512_set1_pd(a[n]));
+  __m512d pi = zero;
+  __m512d dr = zero;
+  __m512d di = zero;
+  __m512d bound = _mm512_mul_pd(_mm512_abs_pd(pr), _mm512_set1_pd(0.5));
+
+  for (std::size_t k = 1; k <= n; ++k) {
+    const __m512d coefficient = _mm512_mask_blend_pd(
+        inside, _mm512_set1_pd(a[k]), _mm512_set1_pd(a[n - k]));
+    const __m512d next_dr =
+        _mm512_fmadd_pd(dr, xr, _mm512_fnmadd_pd(di, xi, pr));
+    const __m512d next_di =
+        _mm512_fmadd_pd(dr, xi, _mm512_fmadd_pd(di, xr, pi));
+    const __m512d next_pr =
+        _mm512_fmadd_pd(pr, xr, _mm512_fnmadd_pd(pi, xi, coefficient));
+    const __m512d next_pi = _mm512_fmadd_pd(pr, xi, _mm512_mul_pd(pi, xr));
+
+    dr = next_dr;
+    di = next_di;
+    pr = next_pr;
+    pi = next_pi;
+    bound = _mm512_fmadd_pd(
+        bound, modulus, _mm512_add_pd(_mm512_abs_pd(pr), _mm512_abs_pd(pi)));
+  }
+  alignas(64) double lane[7][lanes];
+
+  _mm512_store_pd(lane[0], xr);
+  _mm512_store_pd(lane[1], xi);
+  _mm512_store_pd(lane[2], pr);
+  _mm512_store_pd(lane[3], pi);
+  _mm512_store_pd(lane[4], dr);
+  _mm512_store_pd(lane[5], di);
+  _mm512_store_pd(lane[6], bound);
+  for (std::size_t l = 0; l < lanes; ++l) {
+    out[l] = Evaluation{lane[0][l], lane[1][l], (inside >> l & 1u) != 0,
+                        lane[2][l], lane[3][l], lane[4][l],
+                        lane[5][l], lane[6][l]};
+  }
+}
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+constexpr std::size_t lanes{4};
+
+void interaction(const double *zr, const double *zi, std::size_t begin,
+                 const std::size_t end, const double xr, const double xi,
+                 double &sr, double &si) {
+  const __m256d one = _mm256_set1_pd(1);
+  const __m256d vxr = _mm256_set1_pd(xr);
+  const __m256d vxi = _mm256_set1_pd(xi);
+  __m256d       vsr = _mm256_setzero_pd();
+  __m256d       vsi = _mm256_setzero_pd();
+
+  for (; begin + lanes <= end; begin += lanes) {
+    const __m256d dr = _mm256_sub_pd(vxr, _mm256_loadu_pd(zr + begin));
+    const __m256d di = _mm256_sub_pd(vxi, _mm256_loadu_pd(zi + begin));
+    const __m256d inverse =
+        _mm256_div_pd(one, _mm256_fmadd_pd(dr, dr, _mm256_mul_pd(di, di)));
+
+    vsr = _mm256_fmadd_pd(dr, inverse, vsr);
+    vsi = _mm256_fnmadd_pd(di, inverse, vsi);
+  }
+  alignas(32) double lane_r[lanes];
+  alignas(32) double lane_i[lanes];
+
+  _mm256_store_pd(lane_r, vsr);
+  _mm256_store_pd(lane_i, vsi);
+  sr += (lane_r[0] + lane_r[1]) + (lane_r[2] + lane_r[3]);
+  si += (lane_i[0] + lane_i[1]) + (lane_i[2] + lane_i[3]);
+  interactionTail(zr, zi, begin, end, xr, xi, sr, si);
+}
+
+void horner(const std::vector<double> &a, const double *zr, const double *zi,
+            Evaluation *out) {
+  const std::size_t n = a.size() - 1;
+  const __m256d     zero = _mm256_setzero_pd();
+  const __m256d     sign = _mm256_set1_pd(-0.0);
+  const __m256d     vzr = _mm256_loadu_pd(zr);
+  const __m256d     vzi = _mm256_loadu_pd(zi);
+  const __m256d     modulus2 =
+      _mm256_fmadd_pd(vzr, vzr, _mm256_mul_pd(vzi, vzi));
+  const __m256d inside =
+      _mm256_cmp_pd(modulus2, _mm256_set1_pd(1), _CMP_LE_OQ);
+  const __m256d xr =
+      _mm256_blendv_pd(_mm256_div_pd(vzr, modulus2), vzr, inside);
+  const __m256d xi = _mm256_blendv_pd(
+      _mm256_div_pd(_mm256_sub_pd(zero, vzi), modulus2), vzi, inside);
+  const __m256d modulus =
+      _mm256_sqrt_pd(_mm256_fmadd_pd(xr, xr, _mm256_mul_pd(xi, xi)));
+  __m256d pr =
+      _mm256_blendv_pd(_mm256_set1_pd(a[0]), _mm256_set1_pd(a[n]), inside);
+  __m256d pi = zero;
+  __m256d dr = zero;
+  __m256d di = zero;
+  __m256d bound =
+      _mm256_mul_pd(_mm256_andnot_pd(sign, pr), _mm256_set1_pd(0.5));
+
+  for (std::size_t k = 1; k <= n; ++k) {
+    const __m256d coefficient = _mm256_blendv_pd(
+        _mm256_set1_pd(a[k]), _mm256_set1_pd(a[n - k]), inside);
+    const __m256d next_dr =
+        _mm256_fmadd_pd(dr, xr, _mm256_fnmadd_pd(di, xi, pr));
+    const __m256d next_di =
+        _mm256_fmadd_pd(dr, xi, _mm256_fmadd_pd(di, xr, pi));
+    const __m256d next_pr =
+        _mm256_fmadd_pd(pr, xr, _mm256_fnmadd_pd(pi, xi, coefficient));
+    const __m256d next_pi = _mm256_fmadd_pd(pr, xi, _mm256_mul_pd(pi, xr));
+
+    dr = next_dr;
+    di = next_di;
+    pr = next_pr;
+    pi = next_pi;
+    bound = _mm256_fmadd_pd(bound, modulus,
+                            _mm256_add_pd(_mm256_andnot_pd(sign, pr),
+                                          _mm256_andnot_pd(sign, pi)));
+  }
+  alignas(32) double lane[8][lanes];
+
+  _mm256_store_pd(lane[0], xr);
+  _mm256_store_pd(lane[1], xi);
+  _mm256_store_pd(lane[2], pr);
+  _mm256_store_pd(lane[3], pi);
+  _mm256_store_pd(lane[4], dr);
+  _mm256_store_pd(lane[5], di);
+  _mm256_store_pd(lane[6], bound);
+  _mm256_store_pd(lane[7], inside);
+  for (std::size_t l = 0; l < lanes; ++l) {
+    out[l] = Evaluation{lane[0][l], lane[1][l], std::signbit(lane[7][l]),
+                        lane[2][l], lane[3][l], lane[4][l],
+                        lane[5][l], lane[6][l]};
+  }
+}
+
+#else
+
+constexpr std::size_t lanes{1};
+
+void interaction(const double *zr, const double *zi, const std::size_t begin,
+                 const std::size_t end, const double xr, const double xi,
+                 double &sr, double &si) {
+  interactionTail(zr, zi, begin, end, xr, xi, sr, si);
+}
+
+void horner(const std::vector<double> &a, const double *zr, const double *zi,
+            Evaluation *out) {
+  const std::size_t n = a.size() - 1;
+  const double      modulus2 = *zr * *zr + *zi * *zi;
+  const bool        inside = modulus2 <= 1;
+  const double      xr = inside ? *zr : *zr / modulus2;
+  const double      xi = inside ? *zi : -*zi / modulus2;
+  const double      modulus = std::sqrt(xr * xr + xi * xi);
+  double            pr = inside ? a[n] : a[0];
+  double            pi = 0;
+  double            dr = 0;
+  double            di = 0;
+  double            bound = std::abs(pr) / 2;
+
+  for (std::size_t k = 1; k <= n; ++k) {
+    const double coefficient = inside ? a[n - k] : a[k];
+    const double next_dr = dr * xr - di * xi + pr;
+    const double next_di = dr * xi + di * xr + pi;
+    const double next_pr = pr * xr - pi * xi + coefficient;
+    const double next_pi = pr * xi + pi * xr;
+
+    dr = next_dr;
+    di = next_di;
+    pr = next_pr;
+    pi = next_pi;
+    bound = bound * modulus + std::abs(pr) + std::abs(pi);
+  }
+  *out = Evaluation{xr, xi, inside, pr, pi, dr, di, bound};
+}
+
+#endif
+
+/// @brief the Newton step p(z) / p'(z) from an evaluation at z
+/// @return true if p(z) is within the rounding error of its evaluation,
+/// where no step can improve z any further
+bool newton(const std::size_t n, const double zr, const double zi,
+            const Evaluation &e, double &nr, double &ni) {
+  const double residual = std::hypot(e.pr, e.pi);
+
+  if (e.inside) {
+    divide(e.pr, e.pi, e.dr, e.di, nr, ni);
+  } else {
+    // p / p' = z * q(x) / (n * q(x) - x * q'(x)), with q the reversed p
+    const double qr = n * e.pr - (e.xr * e.dr - e.xi * e.di);
+    const double qi = n * e.pi - (e.xr * e.di + e.xi * e.dr);
+    double       ratio_r{0};
+    double       ratio_i{0};
+
+    divide(e.pr, e.pi, qr, qi, ratio_r, ratio_i);
+    nr = zr * ratio_r - zi * ratio_i;
+    ni = zr * ratio_i + zi * ratio_r;
+  }
+  return residual <= 2 * epsilon * (2 * e.bound - residual);
+}
+
+/// @brief the Aberth correction of count roots, from the roots of the
+/// previous iteration
+void correct(State &state, const double tolerance, const std::size_t *group,
+             const std::size_t count) {
+  const std::size_t  n = state.zr.size();
+  alignas(64) double zr[lanes];
+  alignas(64) double zi[lanes];
+  Evaluation         evaluations[lanes];
+
+  // pad a short group with its first root
+  for (std::size_t l = 0; l < lanes; ++l) {
+    zr[l] = state.zr[group[l < count ? l : 0]];
+    zi[l] = state.zi[group[l < count ? l : 0]];
+  }
+  horner(state.a, zr, zi, evaluations);
+
+  for (std::size_t l = 0; l < count; ++l) {
+    const std::size_t i = group[l];
+    double            nr{0};
+    double            ni{0};
+
+    if (newton(state.a.size() - 1, zr[l], zi[l], evaluations[l], nr, ni)) {
+      state.done[i] = true;
+      continue;
+    }
+    double sr{0};
+    double si{0};
+
+    interaction(state.zr.data(), state.zi.data(), 0, i, zr[l], zi[l], sr, si);
+    interaction(state.zr.data(), state.zi.data(), i + 1, n, zr[l], zi[l], sr,
+                si);
+
+    // w = N / (1 - N * S), falling back to the Newton step N itself where
+    // the roots are about to collide
+    double wr{0};
+    double wi{0};
+
+    divide(nr, ni, 1 - (nr * sr - ni * si), -(nr * si + ni * sr), wr, wi);
+    if (!std::isfinite(wr) || !std::isfinite(wi)) {
+      wr = nr;
+      wi = ni;
+    }
+    state.wr[i] = wr;
+    state.wi[i] = wi;
+    state.done[i] = std::hypot(wr, wi) <= tolerance * std::hypot(zr[l], zi[l]);
+  }
+}
+
+/// @brief the Aberth correction of every root in [begin, end) that is not
+/// done yet, lanes roots at a time
+void corrections(State &state, const double tolerance, const std::size_t begin,
+                 const std::size_t end) {
+  std::size_t group[lanes];
+  std::size_t count{0};
+
+  for (std::size_t i = begin; i < end; ++i) {
+    state.wr[i] = 0;
+    state.wi[i] = 0;
+    if (!state.done[i]) {
+      group[count++] = i;
+    }
+    if (count == lanes || (count && i + 1 == end)) {
+      correct(state, tolerance, group, count);
+      count = 0;
+    }
+  }
+}
+
+/// @brief for every root z in [begin, end), the radius of a disc around z
+/// that holds a root of p: the smaller of n |p(z) / p'(z)| and
+/// (|p(z)| / |a[n]|)^(1/n), with |p(z)| raised by the rounding error of its
+/// evaluation. The first is tight at simple roots, the second still bounds
+/// where p' vanishes.
+void errors(State &state, const std::size_t begin, const std::size_t end) {
+  const std::size_t  n = state.zr.size();
+  const double       leading = std::abs(state.a[n]);
+  alignas(64) double zr[lanes];
+  alignas(64) double zi[lanes];
+  Evaluation         evaluations[lanes];
+
+  for (std::size_t first = begin; first < end; first += lanes) {
+    for (std::size_t l = 0; l < lanes; ++l) {
+      zr[l] = state.zr[first + l < end ? first + l : first];
+      zi[l] = state.zi[first + l < end ? first + l : first];
+    }
+    horner(state.a, zr, zi, evaluations);
+    for (std::size_t l = 0; l < lanes && first + l < end; ++l) {
+      const Evaluation &e = evaluations[l];
+      const double residual = std::hypot(e.pr, e.pi) + 2 * epsilon * e.bound;
+      // outside the unit circle p(z) = z^n q(x), with q the reversed p, and
+      // p / p' = z q(x) / (n q(x) - x q'(x))
+      const double scale = e.inside ? 1 : std::hypot(zr[l], zi[l]);
+      const double derivative =
+          e.inside ? std::hypot(e.dr, e.di)
+                   : std::hypot(n * e.pr - (e.xr * e.dr - e.xi * e.di),
+                                n * e.pi - (e.xr * e.di + e.xi * e.dr));
+
+      // the corrections' storage is free once iterating is over
+      state.wr[first + l] =
+          std::min(n * scale * residual / derivative,
+                   scale * std::pow(residual / leading, 1.0 / n));
+    }
+  }
+}
+
+/// @brief run f(begin, end) over [0, n) split across the pool, and wait
+template <typename F>
+void parallel(ThreadPool &pool, const std::size_t n, F &&f) {
+  const unsigned          tasks = pool.size() * tasks_per_worker;
+  const std::size_t       chunk = (n + tasks - 1) / tasks;
+  std::mutex              mutex;
+  std::condition_variable finished;
+  unsigned                remaining{tasks};
+
+  for (unsigned task = 0; task < tasks; ++task) {
+    const std::size_t begin = std::min(n, task * chunk);
+    const std::size_t end = std::min(n, begin + chunk);
+
+    pool.submit([&f, &mutex, &finished, &remaining, begin, end] {
+      f(begin, end);
+      std::lock_guard<std::mutex> lock{mutex};
+      if (!--remaining) {
+        finished.notify_one();
+      }
+    });
+  }
+  std::unique_lock<std::mutex> lock{mutex};
+  finished.wait(lock, [&remaining] { return !remaining; });
+}
+
+/// @brief n points on the circle whose radius is the geometric mean of the
+/// moduli of the roots
+void initialGuesses(State &state) {
+  const std::size_t n = state.a.size() - 1;
+  const double      radius = std::exp(
+      (std::log(std::abs(state.a[0])) - std::log(std::abs(state.a[n]))) / n);
+
+  for (std::size_t k = 0; k < n; ++k) {
+    const double angle = tau * k / n + initial_angle;
+
+    state.zr[k] = radius * std::cos(angle);
+    state.zi[k] = radius * std::sin(angle);
+  }
+}
+
+unsigned workers(const Convergence &convergence) {
+  if (convergence.threads) {
+    return convergence.threads;
+  }
+  const unsigned hardware = std::thread::hardware_concurrency();
+  return hardware ? hardware : 1;
+}
+
+/// @brief the pool of a thread count, started by the first call that needs
+/// it and shared by every later one, so solving spawns no threads
+ThreadPool &sharedPool(const unsigned threads) {
+  static std::mutex                                      mutex;
+  static std::map<unsigned, std::unique_ptr<ThreadPool>> pools;
+  const std::lock_guard<std::mutex>                      lock{mutex};
+  std::unique_ptr<ThreadPool>                           &pool = pools[threads];
+
+  if (!pool) {
+    pool = std::make_unique<ThreadPool>(threads);
+  }
+  return *pool;
+}
+
+}  // namespace
+
+/// @brief every root of a polynomial by the Aberth-Ehrlich simultaneous
+/// iteration. All corrections of an iteration are computed from the roots
+/// of the previous one, so the result does not depend on the thread count.
+/// @param coefficients coefficients[k] multiplies x^k
+PolynomialRoots polynomial_roots(const std::vector<double> &coefficients,
+                                 const Convergence &convergence) {
+  for (const double coefficient : coefficients) {
+    if (!std::isfinite(coefficient)) {
+      throw std::invalid_argument("coefficients must be finite");
+    }
+  }
+  std::size_t high = coefficients.size();
+  std::size_t low = 0;
+
+  while (high && !coefficients[high - 1]) {
+    --high;
+  }
+  if (high <= 1) {
+    throw std::invalid_argument("a constant polynomial has no roots");
+  }
+  while (!coefficients[low]) {
+    ++low;
+  }
+  // every coefficient below the lowest non-zero one is a root at 0
+  PolynomialRoots result{std::vector<double>(low, 0.0),
+                         std::vector<double>(low, 0.0),
+                         std::vector<double>(low, 0.0), 0, true};
+  const std::size_t n = high - low - 1;
+
+  if (!n) {
+    return result;
+  }
+  State state{{coefficients.begin() + low, coefficients.begin() + high},
+              std::vector<double>(n),
+              std::vector<double>(n),
+              std::vector<double>(n),
+              std::vector<double>(n),
+              std::vector<char>(n, false)};
+  const unsigned threads = workers(convergence);
+  // on a worker, as in a batch, the other workers already use the cores
+  ThreadPool *const shared =
+      n >= convergence.parallel_degree && threads > 1 &&
+              !ThreadPool::onWorker()
+          ? &sharedPool(threads)
+          : nullptr;
+
+  initialGuesses(state);
+
+  const auto step = [&state, &convergence](const std::size_t begin,
+                                           const std::size_t end) {
+    corrections(state, convergence.tolerance, begin, end);
+  };
+  bool done{false};
+
+  while (!done && result.iterations < convergence.max_iterations) {
+    if (shared) {
+      parallel(*shared, n, step);
+    } else {
+      step(0, n);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      state.zr[i] -= state.wr[i];
+      state.zi[i] -= state.wi[i];
+    }
+    ++result.iterations;
+    done = std::all_of(state.done.begin(), state.done.end(),
+                       [](const char root) { return root; });
+  }
+  const auto bound = [&state](const std::size_t begin, const std::size_t end) {
+    errors(state, begin, end);
+  };
+
+  if (shared) {
+    parallel(*shared, n, bound);
+  } else {
+    bound(0, n);
+  }
+  result.converged = done;
+  result.real.insert(result.real.end(), state.zr.begin(), state.zr.end());
+  result.imag.insert(result.imag.end(), state.zi.begin(), state.zi.end());
+  result.error.insert(result.error.end(), state.wr.begin(), state.wr.end());
+  return result;
+}
+
+}  // namespace utils
@@ -0,0 +1,287 @@
+#include "batch.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <system_error>
+#include <vector>
+
+#include "stats.h"
+#include "symbols.h"
+
+namespace batch {
+
+namespace {
+
+/// @brief number of lines solved by one task of the parallel batch
+constexpr std::size_t chunk_lines{1024};
+
+/// @brief chunks in flight per worker before the reader waits for the writer
+constexpr std::size_t chunks_per_worker{4};
+
+/// @brief fixed window of chunk results, written out in input order
+class ReorderBuffer {
+ public:
+  ReorderBuffer(const std::size_t slots) : mutex{}, ready{}, results(slots) {}
+
+  void complete(const std::size_t chunk, std::string output) {
+    Result &result = results[chunk % results.size()];
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      result.output = std::move(output);
+      result.done = true;
+    }
+    ready.notify_all();
+  }
+
+  std::string take(const std::size_t chunk) {
+    Result &result = results[chunk % results.size()];
+
+    std::unique_lock<std::mutex> lock{mutex};
+    ready.wait(lock, [&result] { return result.done; });
+    result.done = false;
+    return std::move(result.output);
+  }
+
+  std::size_t size() const { return results.size(); }
+
+ private:
+  struct Result {
+    std::string output;
+    bool        done{false};
+  };
+
+  std::mutex              mutex;
+  std::condition_variable ready;
+  std::vector<Result>     results;
+};
+
+/// @brief parser and interpreter reused for every line a thread solves, so
+/// a line does not allocate once their buffers have grown
+struct Solver {
+  Parser      par;
+  Interpreter interp;
+};
+
+Solver& solver() {
+  thread_local Solver solver{};
+
+  return solver;
+}
+
+/// @brief solve a single equation with solve(interp, status) and write its
+/// record. Invalid equations are reported through a Status, so a malformed
+/// line costs no more than a valid one; the catch only sees internal errors.
+template <typename Solve>
+void write(const std::size_t number, std::string_view line, Writer& out,
+           Solve&& solve) {
+  out << number << ": ";
+  try {
+    Parser&      par = solver().par;
+    Interpreter& interp = solver().interp;
+    Status       status{};
+
+    symbols::reset();
+    par.stream(line);
+    interp.clear();
+    if (!interp.reduce(par, status) && !status) {
+      status = {Errc::kQuit};
+      stats::error(status.code);
+    }
+    if (!status) {
+      solve(interp, status);
+    }
+    const stats::Timer print{stats::Stage::kPrint};
+
+    if (status) {
+      out << "error: " << status << '\n';
+      return;
+    }
+    if (interp.allReals()) {
+      out << "all real numbers\n";
+      return;
+    }
+    const auto& solutions = interp.getSolutions();
+    for (std::size_t i = 0; i < solutions.size(); ++i) {
+      if (i) {
+        out << ", ";
+      }
+      std::visit([&out](const auto& solution) { out << solution; },
+                 solutions[i]);
+    }
+    out << '\n';
+  } catch (const std::exception& e) {
+    std::string_view message{e.what()};
+
+    while (!message.empty() && std::isspace(message.back())) {
+      message.remove_suffix(1);
+    }
+    out << "error: " << message << '\n';
+  }
+}
+
+/// @brief split off the next chunk of whole lines
+std::string_view nextChunk(std::string_view &input) {
+  std::string_view rest{input};
+
+  for (std::size_t i = 0; i < chunk_lines && !rest.empty(); ++i) {
+    nextLine(rest);
+  }
+  std::string_view chunk = input.substr(0, input.size() - rest.size());
+  input = rest;
+  return chunk;
+}
+
+}  // namespace
+
+/* MappedFile */
+
+MappedFile::MappedFile(const std::string& path) : data{nullptr}, size{0} {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    throw std::system_error(errno, std::generic_category(), path);
+  }
+  struct stat info {};
+  if (::fstat(fd, &info) == -1) {
+    const int error = errno;
+    ::close(fd);
+    throw std::system_error(error, std::generic_category(), path);
+  }
+  size = static_cast<std::size_t>(info.st_size);
+  if (size) {
+    data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), path);
+    }
+    ::madvise(data, size, MADV_SEQUENTIAL);
+  }
+  ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (size) {
+    ::munmap(data, size);
+  }
+}
+
+std::string_view MappedFile::view() const {
+  return {static_cast<const char*>(data), size};
+}
+
+/* Batch */
+
+/// @brief split the next line off the input without copying it
+/// @param input remaining input, advanced past the line and its newline
+/// @return the line without its line terminator
+std::string_view nextLine(std::string_view& input) {
+  const auto       end = input.find('\n');
+  std::string_view line = input.substr(0, end);
+
+  input.remove_prefix(end == std::string_view::npos ? input.size() : end + 1);
+  if (!line.empty() && line.back() == '\r') {
+    line.remove_suffix(1);
+  }
+  return line;
+}
+
+/// @brief solve a single equation and write its result record
+/// records look like "<line>: <solution>, <solution>", "<line>: all real
+/// numbers" or "<line>: error: <message>"
+void record(const std::size_t number, std::string_view line,
+            std::ostream& os) {
+  Writer out{os};
+
+  record(number, line, out);
+}
+
+void record(const std::size_t number, std::string_view line, Writer& out) {
+  write(number, line, out,
+        [](Interpreter& interp, Status& status) { interp.solve(status); });
+}
+
+/// @brief same as record, looking the solutions up in a cache first
+void record(const std::size_t number, std::string_view line, std::ostream& os,
+            SolutionCache& cache) {
+  Writer out{os};
+
+  record(number, line, out, cache);
+}
+
+void record(const std::size_t number, std::string_view line, Writer& out,
+            SolutionCache& cache) {
+  write(number, line, out, [&cache](Interpreter& interp, Status& status) {
+    interp.solve(cache, status);
+  });
+}
+
+/// @brief solve every line of the input, one record per line
+void run(std::string_view input, std::ostream& os) {
+  SolutionCache cache{cache_entries};
+
+  run(input, os, cache);
+}
+
+/// @brief solve every line of the input through a cache shared with the
+/// caller, which can read its counters afterwards
+void run(std::string_view input, std::ostream& os, SolutionCache& cache) {
+  Writer out{os};
+
+  for (std::size_t number = 1; !input.empty(); ++number) {
+    record(number, nextLine(input), out, cache);
+  }
+}
+
+/// @brief solve the input on a pool of workers; chunks of lines are solved
+/// in any order and their records are written in input order
+void run(std::string_view input, std::ostream& os, const unsigned jobs) {
+  SolutionCache cache{cache_entries};
+
+  run(input, os, jobs, cache);
+}
+
+/// @brief parallel run through a cache shared by every worker
+void run(std::string_view input, std::ostream& os, const unsigned jobs,
+         SolutionCache& cache) {
+  if (jobs <= 1) {
+    return run(input, os, cache);
+  }
+  ReorderBuffer reorder{jobs * chunks_per_worker};
+  ThreadPool    pool{jobs};
+  std::size_t   submitted{0};
+  std::size_t   written{0};
+  std::size_t   line{1};
+
+  while (!input.empty() || written < submitted) {
+    while (!input.empty() && submitted - written < reorder.size()) {
+      const std::string_view chunk = nextChunk(input);
+      const std::size_t      index = submitted++;
+
+      pool.submit([&reorder, &cache, chunk, index, first = line] {
+        std::string      output;
+        std::string_view lines{chunk};
+        {
+          Writer out{output};
+
+          for (std::size_t number = first; !lines.empty(); ++number) {
+            record(number, nextLine(lines), out, cache);
+          }
+        }
+        reorder.complete(index, std::move(output));
+      });
+      line += chunk_lines;
+    }
+    os << reorder.take(written++);
+  }
+}
+
+}  // namespace batch
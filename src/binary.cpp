@@ -0,0 +1,265 @@
+#include "binary.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "interpreter.h"
+#include "quadratic.h"
+#include "stats.h"
+#include "status.h"
+#include "utils.h"
+#include "writer.h"
+
+namespace binary {
+
+namespace {
+
+constexpr std::size_t npos{std::numeric_limits<std::size_t>::max()};
+
+/// @brief reverse the bytes of a value on big-endian hosts, a no-op else
+template <typename T>
+T little(T value) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  unsigned char bytes[sizeof(T)];
+
+  std::memcpy(bytes, &value, sizeof(T));
+  std::reverse(bytes, bytes + sizeof(T));
+  std::memcpy(&value, bytes, sizeof(T));
+#endif
+  return value;
+}
+
+/// @brief read a little-endian value from possibly unaligned memory
+template <typename T>
+T load(const char *data) {
+  T value;
+
+  std::memcpy(&value, data, sizeof(T));
+  return little(value);
+}
+
+template <typename T>
+void store(std::string &output, T value) {
+  char bytes[sizeof(T)];
+
+  value = little(value);
+  std::memcpy(bytes, &value, sizeof(T));
+  output.append(bytes, sizeof(T));
+}
+
+/// @brief a record of the mapped input, decoded on demand
+class Record {
+ public:
+  Record(const char *d, const unsigned max) : data{d}, max_degree{max} {}
+
+  unsigned degree() const { return static_cast<unsigned char>(data[0]); }
+  char     var() const { return data[1]; }
+  double   coefficient(const unsigned exp) const {
+    return load<double>(data + record_header_size + exp * sizeof(double));
+  }
+
+  /// @brief degree and variable in range and every used coefficient finite
+  bool valid() const {
+    if (degree() > max_degree || var() < 'A' || var() > 'Z') {
+      return false;
+    }
+    for (unsigned exp = 0; exp <= degree(); ++exp) {
+      if (!std::isfinite(coefficient(exp))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// @brief highest exponent with a non-zero coefficient, -1 if none
+  int reducedDegree() const {
+    for (int exp = static_cast<int>(degree()); exp >= 0; --exp) {
+      if (coefficient(static_cast<unsigned>(exp))) {
+        return exp;
+      }
+    }
+    return -1;
+  }
+
+ private:
+  const char *data;
+  unsigned    max_degree;
+};
+
+/// @brief quadratics of a chunk as structures of arrays, for the vectorised
+/// solver
+struct Quadratics {
+  std::vector<double>       a, b, c;
+  std::vector<double>       root1, root2, imag;
+  std::vector<utils::Roots> kind;
+
+  std::size_t add(const Record &record) {
+    c.push_back(record.coefficient(0));
+    b.push_back(record.coefficient(1));
+    a.push_back(record.coefficient(2));
+    return a.size() - 1;
+  }
+
+  void solve() {
+    root1.resize(a.size());
+    root2.resize(a.size());
+    imag.resize(a.size());
+    kind.resize(a.size());
+    utils::quadratic_batch_solver(a.data(), b.data(), c.data(), a.size(),
+                                  root1.data(), root2.data(), imag.data(),
+                                  kind.data());
+  }
+
+  /// @brief in the order quadratic_equation_solver returns them
+  void write(const std::size_t i, Writer &out) const {
+    switch (kind[i]) {
+      case utils::Roots::kDouble:
+        out << root1[i];
+        break;
+      case utils::Roots::kReal:
+        out << root1[i] << ", " << root2[i];
+        break;
+      case utils::Roots::kComplex:
+        out << utils::Complex{root1[i], -imag[i]} << ", "
+            << utils::Complex{root2[i], imag[i]};
+        break;
+      case utils::Roots::kNone:
+        break;
+    }
+  }
+
+  void clear() {
+    a.clear();
+    b.clear();
+    c.clear();
+  }
+};
+
+/// @brief solve any other record through the interpreter's reduced form
+void write(const Record &record, Interpreter &interp,
+           std::vector<double> &coefficients, Writer &out) {
+  Status status{};
+
+  if (!record.valid()) {
+    status = {Errc::kInvalidRecord};
+    stats::error(status.code);
+  } else {
+    for (unsigned exp = 0; exp <= record.degree(); ++exp) {
+      coefficients[exp] = record.coefficient(exp);
+    }
+    interp.load(record.var(), coefficients.data(), record.degree() + 1);
+    interp.solve(status);
+  }
+  if (status) {
+    out << "error: " << status;
+    return;
+  } else if (interp.allReals()) {
+    out << "all real numbers";
+    return;
+  }
+  const auto &solutions = interp.getSolutions();
+  for (std::size_t i = 0; i < solutions.size(); ++i) {
+    if (i) {
+      out << ", ";
+    }
+    std::visit([&out](const auto &solution) { out << solution; },
+               solutions[i]);
+  }
+}
+
+}  // namespace
+
+std::size_t recordSize(const unsigned max_degree) {
+  return record_header_size + (max_degree + std::size_t{1}) * sizeof(double);
+}
+
+/// @brief decode and check the header against the size of the input
+Header header(std::string_view input) {
+  if (input.size() < header_size || input.substr(0, magic.size()) != magic) {
+    throw std::invalid_argument("not a computorv1 binary file");
+  }
+  const Header head{load<std::uint16_t>(input.data() + 4),
+                    load<std::uint16_t>(input.data() + 6),
+                    load<std::uint64_t>(input.data() + 8)};
+
+  if (head.version != version) {
+    throw std::invalid_argument("unsupported binary file version " +
+                                std::to_string(head.version));
+  }
+  if (head.count > (input.size() - header_size) / recordSize(head.max_degree)) {
+    throw std::invalid_argument("binary file is truncated");
+  }
+  return head;
+}
+
+/// @brief solve every record of the input, one batch record each, in
+/// order. The quadratics of each chunk are solved together by the
+/// vectorised solver; every other record goes through the interpreter.
+void run(std::string_view input, std::ostream &os) {
+  const Header        head = header(input);
+  const std::size_t   size = recordSize(head.max_degree);
+  const char         *records = input.data() + header_size;
+  Interpreter         interp{};
+  Quadratics          quadratics{};
+  std::vector<double> coefficients(head.max_degree + std::size_t{1});
+  std::vector<std::size_t> slots(chunk_records);
+  Writer                   out{os};
+
+  for (std::uint64_t first = 0; first < head.count; first += chunk_records) {
+    const std::size_t n = static_cast<std::size_t>(
+        std::min<std::uint64_t>(chunk_records, head.count - first));
+
+    quadratics.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+      const Record record{records + (first + i) * size, head.max_degree};
+
+      slots[i] = record.valid() && record.reducedDegree() == 2
+                     ? quadratics.add(record)
+                     : npos;
+    }
+    quadratics.solve();
+    if (stats::enabled()) {
+      stats::count(stats::Counter::kEquations, n);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      out << first + i + 1 << ": ";
+      if (slots[i] != npos) {
+        quadratics.write(slots[i], out);
+      } else {
+        write(Record{records + (first + i) * size, head.max_degree}, interp,
+              coefficients, out);
+      }
+      out << '\n';
+    }
+  }
+}
+
+/// @brief encode a header, for writers of the format
+void appendHeader(std::string &output, const unsigned max_degree,
+                  const std::uint64_t count) {
+  output.append(magic);
+  store<std::uint16_t>(output, version);
+  store<std::uint16_t>(output, static_cast<std::uint16_t>(max_degree));
+  store<std::uint64_t>(output, count);
+}
+
+/// @brief encode a record of the reduced form with the given coefficients,
+/// in ascending order of exponent
+void appendRecord(std::string &output, const unsigned max_degree,
+                  const char var, const std::vector<double> &coefficients) {
+  if (coefficients.empty() || coefficients.size() > max_degree + 1u) {
+    throw std::invalid_argument("a record holds 1 to max degree + 1 "
+                                "coefficients");
+  }
+  output.push_back(static_cast<char>(coefficients.size() - 1));
+  output.push_back(var);
+  output.append(record_header_size - 2, '\0');
+  for (unsigned exp = 0; exp <= max_degree; ++exp) {
+    store<double>(output, exp < coefficients.size() ? coefficients[exp] : 0.0);
+  }
+}
+
+}  // namespace binary
@@ -0,0 +1,180 @@
+#include "cache.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "diskcache.h"
+
+namespace {
+
+std::uint64_t bits(const double value) {
+  std::uint64_t result{0};
+
+  std::memcpy(&result, &value, sizeof(result));
+  return result;
+}
+
+/// @brief splitmix64 finaliser
+std::uint64_t mix(std::uint64_t value) {
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ull;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebull;
+  return value ^ (value >> 31);
+}
+
+/// @brief the binary exponents of the coefficients a key scales: the
+/// products, quotients and square roots of the solvers stay normal within
+/// them, and the discriminant well inside the range it is trusted in
+constexpr int max_key_exponent{200};
+
+bool moderate(const double x) {
+  return !x || std::abs(std::ilogb(x)) <= max_key_exponent;
+}
+
+}  // namespace
+
+/* Key */
+
+bool SolutionCache::Key::operator==(const Key &other) const {
+  return bits(a) == bits(other.a) && bits(b) == bits(other.b) &&
+         bits(c) == bits(other.c);
+}
+
+std::size_t SolutionCache::Hash::operator()(const Key &key) const {
+  return static_cast<std::size_t>(
+      mix(bits(key.a) ^ mix(bits(key.b) ^ mix(bits(key.c)))));
+}
+
+/* SolutionCache */
+
+SolutionCache::SolutionCache(const std::size_t capacity)
+    : mutex{}, entries{}, index{}, limit{capacity}, disk{nullptr}, hit{0},
+      miss{0}, disk_hit{0} {}
+
+SolutionCache::SolutionCache(const std::size_t capacity, DiskCache &backing)
+    : mutex{}, entries{}, index{}, limit{capacity}, disk{&backing}, hit{0},
+      miss{0}, disk_hit{0} {}
+
+/// @brief look the solutions of a key up and mark them most recently used;
+/// solutions found on disk are kept in memory from then on
+std::optional<SolutionCache::solutions_t> SolutionCache::find(const Key &key) {
+  solutions_t solutions;
+
+  if (find(key, solutions)) {
+    return solutions;
+  }
+  return std::nullopt;
+}
+
+/// @brief same, copying a hit into solutions, which keeps its capacity
+/// @return false on a miss, leaving solutions alone
+bool SolutionCache::find(const Key &key, solutions_t &solutions) {
+  std::lock_guard<std::mutex> lock{mutex};
+  const auto                  it = index.find(key);
+
+  if (it != index.end()) {
+    hit.fetch_add(1, std::memory_order_relaxed);
+    entries.splice(entries.begin(), entries, it->second);
+    solutions = it->second->second;
+    return true;
+  }
+  if (disk) {
+    if (auto found = disk->find(key)) {
+      hit.fetch_add(1, std::memory_order_relaxed);
+      disk_hit.fetch_add(1, std::memory_order_relaxed);
+      store(key, *found);
+      solutions = std::move(*found);
+      return true;
+    }
+  }
+  miss.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+/// @brief store the solutions of a key, in memory and on disk
+void SolutionCache::insert(const Key &key, solutions_t solutions) {
+  if (disk) {
+    disk->insert(key, solutions);
+  }
+  std::lock_guard<std::mutex> lock{mutex};
+
+  store(key, std::move(solutions));
+}
+
+std::size_t SolutionCache::size() const {
+  std::lock_guard<std::mutex> lock{mutex};
+  return entries.size();
+}
+
+std::size_t SolutionCache::capacity() const { return limit; }
+
+std::size_t SolutionCache::hits() const {
+  return hit.load(std::memory_order_relaxed);
+}
+
+std::size_t SolutionCache::misses() const {
+  return miss.load(std::memory_order_relaxed);
+}
+
+/// @brief hits that were served by the disk cache
+std::size_t SolutionCache::diskHits() const {
+  return disk_hit.load(std::memory_order_relaxed);
+}
+
+/// @brief keep the solutions of a key in memory, evicting the least recently
+/// used entry when the cache is full; the caller holds the lock
+void SolutionCache::store(const Key &key, solutions_t solutions) {
+  if (!limit) {
+    return;
+  }
+  const auto it = index.find(key);
+
+  if (it != index.end()) {
+    it->second->second = std::move(solutions);
+    entries.splice(entries.begin(), entries, it->second);
+    return;
+  }
+  if (entries.size() == limit) {
+    index.erase(entries.back().first);
+    entries.pop_back();
+  }
+  entries.emplace_front(key, std::move(solutions));
+  index.emplace(key, entries.begin());
+}
+
+/// @brief key of a * x^2 + b * x + c, with a or b non-zero. Multiplying
+/// every coefficient by a power of two scales each step of the solvers
+/// exactly, so forms that only differ by one share a key: the leading
+/// coefficient is scaled into [1, 2) for quadratics. linear_equation_solver
+/// picks its formula by whether the slope is above 1 in magnitude, so linear
+/// forms keep that side, with the slope in [2, 4) or [0.5, 1). Forms whose
+/// coefficients, scaled or not, are too large or small for every step to
+/// stay exact are not scaled. -0.0 is keyed as 0.0.
+SolutionCache::Key SolutionCache::key(const double a, const double b,
+                                      const double c) {
+  const double lead = a ? a : b;
+  int          exponent{0};
+
+  std::frexp(lead, &exponent);
+  const int    target = a ? 1 : (std::abs(lead) > 1 ? 2 : 0);
+  const int    shift = target - exponent;
+  const double scaled[]{std::ldexp(a, shift), std::ldexp(b, shift),
+                        std::ldexp(c, shift)};
+
+  if (!moderate(a) || !moderate(b) || !moderate(c) || !moderate(scaled[0]) ||
+      !moderate(scaled[1]) || !moderate(scaled[2])) {
+    return Key{a + 0.0, b + 0.0, c + 0.0};
+  }
+  return Key{scaled[0] + 0.0, scaled[1] + 0.0, scaled[2] + 0.0};
+}
+
+/// @brief solve the polynomial of a key, exactly as the interpreter does
+/// without a cache
+SolutionCache::solutions_t SolutionCache::solve(const Key &key) {
+  if (key.a) {
+    return utils::quadratic_equation_solver(key.a, key.b, key.c);
+  }
+  return solutions_t{utils::linear_equation_solver(key.b, key.c)};
+}
@@ -0,0 +1,310 @@
+#include "diskcache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+namespace {
+
+constexpr char magic[8]{'c', 'v', '1', 'c', 'a', 'c', 'h', 'e'};
+
+/// @brief slots probed for a key before giving up or evicting
+constexpr std::size_t probe_limit{8};
+
+/// @brief layout of the first slot word, never 0 in a used slot
+constexpr std::uint64_t used{1};
+constexpr unsigned      count_shift{8};
+constexpr std::uint64_t conjugates{1u << 16};
+
+std::uint64_t bits(const double value) {
+  std::uint64_t result{0};
+
+  std::memcpy(&result, &value, sizeof(result));
+  return result;
+}
+
+double number(const std::uint64_t bits) {
+  double result{0};
+
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+/// @brief splitmix64 finaliser
+std::uint64_t mix(std::uint64_t value) {
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ull;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebull;
+  return value ^ (value >> 31);
+}
+
+/// @brief of every word of a slot but the last, which holds it; never 0,
+/// unlike the words of an empty slot
+std::uint64_t checksum(const std::uint64_t *words, const std::size_t count) {
+  std::uint64_t result{0};
+
+  for (std::size_t j = 0; j + 1 < count; ++j) {
+    result = mix(result ^ words[j]);
+  }
+  return result | 1u;
+}
+
+/// @brief smallest power of two of at least slots and probe_limit
+std::size_t roundUp(const std::size_t slots) {
+  std::size_t result{probe_limit};
+
+  while (result < slots) {
+    result <<= 1u;
+  }
+  return result;
+}
+
+bool matches(const std::uint64_t *words, const SolutionCache::Key &key) {
+  return words[1] == bits(key.a) && words[2] == bits(key.b) &&
+         words[3] == bits(key.c);
+}
+
+/// @brief whether solutions are real numbers only, or a conjugate pair
+/// @return false for anything else, which a slot has no room for
+bool fits(const SolutionCache::solutions_t &solutions, bool &pair) {
+  const auto *first = solutions.empty()
+                          ? nullptr
+                          : std::get_if<utils::Complex>(&solutions.front());
+
+  pair = first;
+  if (!first) {
+    return solutions.size() <= 2 &&
+           std::all_of(solutions.begin(), solutions.end(), [](const auto &x) {
+             return std::holds_alternative<double>(x);
+           });
+  }
+  const auto *second = solutions.size() == 2
+                           ? std::get_if<utils::Complex>(&solutions.back())
+                           : nullptr;
+
+  return second && bits(first->real) == bits(second->real) &&
+         bits(first->imag) == bits(-second->imag);
+}
+
+}  // namespace
+
+/* DiskCache */
+
+DiskCache::DiskCache(const std::string &path, const std::size_t slots)
+    : data{nullptr}, size{0}, table{nullptr}, mask{0} {
+  if (map(path)) {
+    return;
+  }
+  create(path, roundUp(slots));
+  if (!map(path)) {
+    throw std::runtime_error("can not open cache file " + path);
+  }
+}
+
+DiskCache::~DiskCache() {
+  if (data) {
+    ::munmap(data, size);
+  }
+}
+
+/// @brief look a key up without taking any lock; a slot changed while it
+/// was read is read again, one whose words are torn, by a write in progress
+/// or a writer that died, is skipped
+std::optional<DiskCache::solutions_t> DiskCache::find(const Key &key) const {
+  const std::size_t home = SolutionCache::Hash{}(key);
+
+  for (std::size_t i = 0; i < probe_limit; ++i) {
+    const Slot &slot = table[(home + i) & mask];
+
+    for (;;) {
+      const std::uint64_t before =
+          slot.sequence.load(std::memory_order_acquire);
+      std::uint64_t       words[slot_words];
+
+      for (std::size_t j = 0; j < slot_words; ++j) {
+        words[j] = slot.words[j].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != before) {
+        continue;
+      }
+      if (!words[0]) {
+        return std::nullopt;
+      }
+      if (words[slot_words - 1] != checksum(words, slot_words) ||
+          !matches(words, key)) {
+        break;
+      }
+      solutions_t solutions;
+
+      if (words[0] & conjugates) {
+        const double real = number(words[4]);
+        const double imag = number(words[5]);
+
+        solutions.emplace_back(utils::Complex{real, -imag});
+        solutions.emplace_back(utils::Complex{real, imag});
+        return solutions;
+      }
+      for (std::size_t j = 0; j < ((words[0] >> count_shift) & 0xff); ++j) {
+        solutions.emplace_back(number(words[4 + j]));
+      }
+      return solutions;
+    }
+  }
+  return std::nullopt;
+}
+
+/// @brief store the solutions of a key in the first free or torn slot of its
+/// probe window, or over an entry of the window when it is full. Gives up when
+/// another writer claims the slot first, or the solutions do not fit; it is
+/// only a cache. A slot claimed by a writer that never finished is claimed
+/// again: were that writer only slow, readers see the words of both torn
+/// apart and skip them by their checksum.
+void DiskCache::insert(const Key &key, const solutions_t &solutions) {
+  bool pair{false};
+
+  if (!fits(solutions, pair)) {
+    return;
+  }
+  const std::size_t hash = SolutionCache::Hash{}(key);
+  std::size_t       victim = (hash + (hash >> 32u) % probe_limit) & mask;
+
+  for (std::size_t i = 0; i < probe_limit; ++i) {
+    const std::size_t index = (hash + i) & mask;
+    std::uint64_t     words[slot_words];
+
+    for (std::size_t j = 0; j < slot_words; ++j) {
+      words[j] = table[index].words[j].load(std::memory_order_relaxed);
+    }
+    if (!words[0] || words[slot_words - 1] != checksum(words, slot_words)) {
+      victim = index;
+      break;
+    }
+    if (matches(words, key)) {
+      return;
+    }
+  }
+  Slot               &slot = table[victim];
+  std::uint64_t       sequence = slot.sequence.load(std::memory_order_relaxed);
+  const std::uint64_t claimed = sequence + ((sequence & 1u) ? 2 : 1);
+
+  if (!slot.sequence.compare_exchange_strong(sequence, claimed,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed)) {
+    return;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+
+  std::uint64_t words[slot_words]{};
+
+  words[0] = used | solutions.size() << count_shift;
+  words[1] = bits(key.a);
+  words[2] = bits(key.b);
+  words[3] = bits(key.c);
+  if (pair) {
+    const auto &complex = std::get<utils::Complex>(solutions.back());
+
+    words[0] |= conjugates;
+    words[4] = bits(complex.real);
+    words[5] = bits(complex.imag);
+  } else {
+    for (std::size_t j = 0; j < solutions.size(); ++j) {
+      words[4 + j] = bits(std::get<double>(solutions[j]));
+    }
+  }
+  words[slot_words - 1] = checksum(words, slot_words);
+  for (std::size_t j = 0; j < slot_words; ++j) {
+    slot.words[j].store(words[j], std::memory_order_relaxed);
+  }
+  slot.sequence.store(claimed + 1, std::memory_order_release);
+}
+
+std::size_t DiskCache::slots() const { return mask + 1; }
+
+/// @brief map path if it holds a table of this format
+/// @return false if the file is missing or of another format
+bool DiskCache::map(const std::string &path) {
+  const int fd = ::open(path.c_str(), O_RDWR);
+  if (fd == -1) {
+    if (errno == ENOENT) {
+      return false;
+    }
+    throw std::system_error(errno, std::generic_category(), path);
+  }
+  struct stat info {};
+  if (::fstat(fd, &info) == -1) {
+    const int error = errno;
+    ::close(fd);
+    throw std::system_error(error, std::generic_category(), path);
+  }
+  const auto bytes = static_cast<std::size_t>(info.st_size);
+  if (bytes < sizeof(Header)) {
+    ::close(fd);
+    return false;
+  }
+  void *mapping =
+      ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  const int error = errno;
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    throw std::system_error(error, std::generic_category(), path);
+  }
+  const auto *header = static_cast<const Header *>(mapping);
+  const bool  valid =
+      !std::memcmp(header->magic, magic, sizeof(magic)) &&
+      header->version == version && header->solver == utils::solver_revision &&
+      header->slot_size == sizeof(Slot) &&
+      header->slots && !(header->slots & (header->slots - 1)) &&
+      header->slots <= (bytes - sizeof(Header)) / sizeof(Slot) &&
+      bytes == sizeof(Header) + header->slots * sizeof(Slot);
+
+  if (!valid) {
+    ::munmap(mapping, bytes);
+    return false;
+  }
+  data = mapping;
+  size = bytes;
+  table = reinterpret_cast<Slot *>(static_cast<char *>(mapping) +
+                                   sizeof(Header));
+  mask = header->slots - 1;
+  return true;
+}
+
+/// @brief build an empty table next to path and rename it over path, so
+/// other processes only ever open complete files. Processes still mapping
+/// a replaced file keep using it until they reopen.
+void DiskCache::create(const std::string &path, const std::size_t slots) {
+  std::string temporary{path + ".XXXXXX"};
+  const int   fd = ::mkstemp(temporary.data());
+
+  if (fd == -1) {
+    throw std::system_error(errno, std::generic_category(), path);
+  }
+  Header header{};
+
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.version = version;
+  header.solver = utils::solver_revision;
+  header.slot_size = sizeof(Slot);
+  header.slots = slots;
+  if (::ftruncate(fd, static_cast<off_t>(sizeof(Header) +
+                                         slots * sizeof(Slot))) == -1 ||
+      ::pwrite(fd, &header, sizeof(header), 0) !=
+          static_cast<ssize_t>(sizeof(header)) ||
+      ::rename(temporary.c_str(), path.c_str()) == -1) {
+    const int error = errno;
+    ::close(fd);
+    ::unlink(temporary.c_str());
+    throw std::system_error(error, std::generic_category(), path);
+  }
+  ::close(fd);
+}
@@ -0,0 +1,345 @@
+#include "expansion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace utils {
+
+namespace {
+
+/* schoolbook and Karatsuba */
+
+/// @brief out[0, na + nb - 1) += a * b
+void schoolbook(const double *a, const std::size_t na, const double *b,
+                const std::size_t nb, double *out) {
+  for (std::size_t i = 0; i < na; ++i) {
+    for (std::size_t j = 0; j < nb; ++j) {
+      out[i + j] += a[i] * b[j];
+    }
+  }
+}
+
+/// @brief out[0, 2n - 1) = a * b for two operands of n coefficients: the
+/// low and high halves of each are multiplied, and their sums, so three
+/// half-size products make the full one. scratch takes 8n doubles.
+void karatsuba(const double *a, const double *b, const std::size_t n,
+               double *out, double *scratch) {
+  if (n < karatsuba_size) {
+    std::fill(out, out + 2 * n - 1, 0.0);
+    schoolbook(a, n, b, n, out);
+    return;
+  }
+  const std::size_t low = n / 2;
+  const std::size_t high = n - low;
+  double           *sa = scratch;
+  double           *sb = sa + high;
+  double           *middle = sb + high;
+
+  karatsuba(a, b, low, out, scratch);
+  out[2 * low - 1] = 0;
+  karatsuba(a + low, b + low, high, out + 2 * low, scratch);
+  for (std::size_t i = 0; i < high; ++i) {
+    sa[i] = a[low + i] + (i < low ? a[i] : 0);
+    sb[i] = b[low + i] + (i < low ? b[i] : 0);
+  }
+  karatsuba(sa, sb, high, middle, middle + 2 * high - 1);
+  for (std::size_t i = 0; i < 2 * low - 1; ++i) {
+    middle[i] -= out[i];
+  }
+  for (std::size_t i = 0; i < 2 * high - 1; ++i) {
+    middle[i] -= out[2 * low + i];
+  }
+  for (std::size_t i = 0; i < 2 * high - 1; ++i) {
+    out[low + i] += middle[i];
+  }
+}
+
+/// @brief Karatsuba on unbalanced operands: the longer one is cut into
+/// pieces the size of the shorter one
+void karatsuba(const std::vector<double> &a, const std::vector<double> &b,
+               std::vector<double> &product) {
+  const std::vector<double> &longer = a.size() < b.size() ? b : a;
+  const std::vector<double> &shorter = a.size() < b.size() ? a : b;
+  const std::size_t          n = shorter.size();
+  std::vector<double>        piece(n);
+  std::vector<double>        partial(2 * n - 1);
+  std::vector<double>        scratch(8 * n);
+
+  product.assign(a.size() + b.size() - 1, 0.0);
+  for (std::size_t first = 0; first < longer.size(); first += n) {
+    const std::size_t count = std::min(n, longer.size() - first);
+
+    std::copy(longer.begin() + first, longer.begin() + first + count,
+              piece.begin());
+    std::fill(piece.begin() + count, piece.end(), 0.0);
+    karatsuba(piece.data(), shorter.data(), n, partial.data(),
+              scratch.data());
+    for (std::size_t i = 0; i < std::min(partial.size(),
+                                         product.size() - first);
+         ++i) {
+      product[first + i] += partial[i];
+    }
+  }
+}
+
+/* number theoretic transform */
+
+/// @brief the largest magnitude a double holds every integer below
+constexpr double exact_limit{9007199254740992.0};
+
+/// @brief arithmetic modulo a prime p < 2^30 on residues kept multiplied
+/// by 2^32 (Montgomery form), where a product is reduced with two
+/// multiplications and a shift instead of a division
+template <std::uint32_t p>
+struct Montgomery {
+  /// @brief -1 / p modulo 2^32, by Newton's iteration
+  static constexpr std::uint32_t negated_inverse() {
+    std::uint32_t x{p};
+
+    for (int i = 0; i < 4; ++i) {
+      x *= 2 - p * x;
+    }
+    return ~x + 1;
+  }
+
+  static constexpr std::uint32_t minus_inverse{negated_inverse()};
+  static constexpr std::uint64_t r{(std::uint64_t{1} << 32) % p};
+  static constexpr std::uint32_t r2{static_cast<std::uint32_t>(r * r % p)};
+
+  static std::uint32_t reduce(const std::uint64_t t) {
+    const std::uint32_t m = static_cast<std::uint32_t>(t) * minus_inverse;
+    const std::uint64_t u = (t + std::uint64_t{m} * p) >> 32;
+
+    return static_cast<std::uint32_t>(u >= p ? u - p : u);
+  }
+  static std::uint32_t multiply(const std::uint32_t a, const std::uint32_t b) {
+    return reduce(std::uint64_t{a} * b);
+  }
+  static std::uint32_t to(const std::uint32_t x) { return multiply(x, r2); }
+  static std::uint32_t from(const std::uint32_t x) { return reduce(x); }
+  static std::uint32_t power(std::uint32_t b, std::uint64_t e) {
+    std::uint32_t result = to(1);
+
+    for (; e; e >>= 1) {
+      if (e & 1) {
+        result = multiply(result, b);
+      }
+      b = multiply(b, b);
+    }
+    return result;
+  }
+};
+
+/// @brief primes of the form k * 2^m + 1 with 3 as primitive root. Their
+/// product exceeds 2^58, so two transforms recover any coefficient below
+/// 2^53 by the Chinese remainder theorem.
+constexpr std::uint32_t first_prime{998244353};
+constexpr std::uint32_t second_prime{469762049};
+constexpr std::uint32_t root{3};
+
+/// @brief in place, n a power of two, from natural order to bit reversed
+/// order (decimation in frequency); twiddles[h + i] holds the i-th power of
+/// the 2h-th root of unity in Montgomery form, so each stage reads its own
+/// run of them in order
+template <std::uint32_t p>
+void forward(std::vector<std::uint32_t>       &a,
+             const std::vector<std::uint32_t> &twiddles) {
+  using mod = Montgomery<p>;
+  const std::size_t n = a.size();
+
+  for (std::size_t half = n / 2; half; half /= 2) {
+    const std::uint32_t *w = twiddles.data() + half;
+
+    for (std::size_t first = 0; first < n; first += 2 * half) {
+      std::uint32_t *lo = a.data() + first;
+      std::uint32_t *hi = lo + half;
+
+      for (std::size_t i = 0; i < half; ++i) {
+        const std::uint32_t u = lo[i];
+        const std::uint32_t v = hi[i];
+
+        lo[i] = u + v < p ? u + v : u + v - p;
+        hi[i] = mod::multiply(u >= v ? u - v : u + p - v, w[i]);
+      }
+    }
+  }
+}
+
+/// @brief the same transform from bit reversed order back to natural order
+/// (decimation in time), so no pass permutes the coefficients
+template <std::uint32_t p>
+void backward(std::vector<std::uint32_t>       &a,
+              const std::vector<std::uint32_t> &twiddles) {
+  using mod = Montgomery<p>;
+  const std::size_t n = a.size();
+
+  for (std::size_t half = 1; half < n; half *= 2) {
+    const std::uint32_t *w = twiddles.data() + half;
+
+    for (std::size_t first = 0; first < n; first += 2 * half) {
+      std::uint32_t *lo = a.data() + first;
+      std::uint32_t *hi = lo + half;
+
+      for (std::size_t i = 0; i < half; ++i) {
+        const std::uint32_t u = lo[i];
+        const std::uint32_t v = mod::multiply(hi[i], w[i]);
+
+        lo[i] = u + v < p ? u + v : u + v - p;
+        hi[i] = u >= v ? u - v : u + p - v;
+      }
+    }
+  }
+}
+
+/// @brief the product modulo p of integer coefficients, by n-point
+/// transforms. Both directions use the powers of the same root, so the
+/// inverse comes out with all outputs but the first reversed.
+template <std::uint32_t p>
+void residues(const std::vector<double> &a, const std::vector<double> &b,
+              const std::size_t n, std::vector<std::uint32_t> &result) {
+  using mod = Montgomery<p>;
+  const auto reduce = [](const double x) {
+    const auto r = static_cast<std::int64_t>(x) % std::int64_t{p};
+
+    return mod::to(static_cast<std::uint32_t>(r < 0 ? r + p : r));
+  };
+  std::vector<std::uint32_t> other(n, 0);
+  std::vector<std::uint32_t> twiddles(n);
+  const std::uint32_t        scale =
+      mod::power(mod::to(static_cast<std::uint32_t>(n)), p - 2);
+
+  for (std::size_t half = n / 2; half; half /= 2) {
+    const std::uint32_t step = mod::power(mod::to(root), (p - 1) / (2 * half));
+
+    twiddles[half] = mod::to(1);
+    for (std::size_t i = 1; i < half; ++i) {
+      twiddles[half + i] = mod::multiply(twiddles[half + i - 1], step);
+    }
+  }
+  result.assign(n, 0);
+  std::transform(a.begin(), a.end(), result.begin(), reduce);
+  std::transform(b.begin(), b.end(), other.begin(), reduce);
+  forward<p>(result, twiddles);
+  forward<p>(other, twiddles);
+  for (std::size_t i = 0; i < n; ++i) {
+    result[i] = mod::multiply(result[i], other[i]);
+  }
+  backward<p>(result, twiddles);
+  std::reverse(result.begin() + 1, result.end());
+  for (std::uint32_t &x : result) {
+    x = mod::from(mod::multiply(x, scale));
+  }
+}
+
+void ntt(const std::vector<double> &a, const std::vector<double> &b,
+         std::vector<double> &product) {
+  using mod = Montgomery<second_prime>;
+  constexpr std::uint64_t modulus{std::uint64_t{first_prime} * second_prime};
+  const std::uint32_t     inverse =
+      mod::power(mod::to(first_prime % second_prime), second_prime - 2);
+  const std::size_t          size = a.size() + b.size() - 1;
+  std::size_t                n{2};
+  std::vector<std::uint32_t> r1;
+  std::vector<std::uint32_t> r2;
+
+  while (n < size) {
+    n <<= 1;
+  }
+  residues<first_prime>(a, b, n, r1);
+  residues<second_prime>(a, b, n, r2);
+  product.resize(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    const std::uint32_t low = r1[i] >= second_prime ? r1[i] - second_prime
+                                                    : r1[i];
+    const std::uint32_t low2 = low >= second_prime ? low - second_prime : low;
+    const std::uint32_t t = mod::multiply(
+        r2[i] >= low2 ? r2[i] - low2 : r2[i] + second_prime - low2, inverse);
+    const std::uint64_t x = r1[i] + std::uint64_t{first_prime} * t;
+
+    product[i] = x > modulus / 2 ? -static_cast<double>(modulus - x)
+                                 : static_cast<double>(x);
+  }
+}
+
+double magnitude(const std::vector<double> &a) {
+  double result{0};
+
+  for (const double x : a) {
+    result = std::max(result, std::abs(x));
+  }
+  return result;
+}
+
+bool integral(const std::vector<double> &a) {
+  return std::all_of(a.begin(), a.end(),
+                     [](const double x) { return std::trunc(x) == x; });
+}
+
+}  // namespace
+
+/// @brief true if the number theoretic transform gives a * b exactly: the
+/// coefficients are integers and no coefficient of the product can reach
+/// 2^53
+bool ntt_exact(const std::vector<double> &a, const std::vector<double> &b) {
+  const double bound = magnitude(a) * magnitude(b) *
+                       static_cast<double>(std::min(a.size(), b.size()));
+
+  return bound < exact_limit && integral(a) && integral(b);
+}
+
+/// @brief the coefficients of a * b, ascending by exponent like the
+/// operands, which must not be empty
+void polynomial_product(const std::vector<double> &a,
+                        const std::vector<double> &b,
+                        std::vector<double>       &product,
+                        const Product              algorithm) {
+  const std::size_t shorter = std::min(a.size(), b.size());
+  Product           chosen = algorithm;
+
+  if (chosen == Product::kAuto) {
+    if (shorter < karatsuba_size) {
+      chosen = Product::kSchoolbook;
+    } else if (shorter >= ntt_size && ntt_exact(a, b)) {
+      chosen = Product::kNtt;
+    } else {
+      chosen = Product::kKaratsuba;
+    }
+  } else if (chosen == Product::kNtt && !ntt_exact(a, b)) {
+    chosen = Product::kKaratsuba;
+  }
+  switch (chosen) {
+    case Product::kNtt:
+      ntt(a, b, product);
+      break;
+    case Product::kKaratsuba:
+      karatsuba(a, b, product);
+      break;
+    default:
+      product.assign(a.size() + b.size() - 1, 0.0);
+      schoolbook(a.data(), a.size(), b.data(), b.size(), product.data());
+      break;
+  }
+}
+
+/// @brief base raised to exponent by repeated squaring, O(log n) products
+void polynomial_power(const std::vector<double> &base, unsigned exponent,
+                      std::vector<double> &power) {
+  std::vector<double> square{base};
+  std::vector<double> scratch;
+
+  power.assign(1, 1.0);
+  while (exponent) {
+    if (exponent & 1u) {
+      polynomial_product(power, square, scratch);
+      power.swap(scratch);
+    }
+    exponent >>= 1u;
+    if (exponent) {
+      polynomial_product(square, square, scratch);
+      square.swap(scratch);
+    }
+  }
+}
+
+}  // namespace utils
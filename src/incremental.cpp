@@ -0,0 +1,258 @@
+#include "incremental.h"
+
+#include <algorithm>
+#include <cctype>
+
+#include "stats.h"
+#include "symbols.h"
+
+namespace {
+
+/// @brief "=", or a "+" or "-" between two operands. Every valid operand
+/// ends with a number, so a sign after a digit or a point is binary, and
+/// unary anywhere else.
+bool separates(const char ch, const char previous) {
+  return ch == '=' ||
+         ((ch == '+' || ch == '-') &&
+          (std::isdigit(static_cast<unsigned char>(previous)) ||
+           previous == '.'));
+}
+
+/// @brief an edit that adds or removes an operator changes the operands
+bool hasOperator(std::string_view text) {
+  return text.find_first_of("+-=()") != std::string_view::npos;
+}
+
+}  // namespace
+
+/* Incremental */
+
+Incremental::Incremental()
+    : par{},
+      rpn{},
+      line{},
+      operands{},
+      folds{},
+      scratch{},
+      keys{},
+      sums{},
+      valid{false},
+      incremental{false} {}
+
+/// @brief reduce an equation, reusing what the previous one reduced
+/// @return false if the equation is invalid, quits or has parentheses;
+/// reduce it the usual way then, which reports why or multiplies out
+bool Incremental::reduce(std::string_view equation) {
+  const stats::Timer timer{stats::Stage::kReduce};
+
+  incremental = valid && update(equation);
+  if (!incremental) {
+    valid = rebuild(equation);
+  }
+  return valid;
+}
+
+/// @brief the reduced form of the last equation reduce accepted
+const Polynomial& Incremental::reduced() const { return rpn.terms; }
+
+/// @brief true if the last equation was reduced from the previous one
+bool Incremental::reused() const { return incremental; }
+
+/// @brief forget the previous equation, so the next one is reduced whole
+void Incremental::clear() {
+  valid = false;
+  incremental = false;
+}
+
+/// @brief call f with every term in the order reduce folds them: the terms
+/// of each operand in turn, but the values of the first operands of each
+/// side last, as "=" folds the right one and the left one is evaluated
+template <typename F>
+void Incremental::forEachInOrder(F&& f) const {
+  const Term* lhs{nullptr};
+  const Term* rhs{nullptr};
+
+  for (const Operand& operand : operands) {
+    const Term* terms = folds.data() + operand.first;
+
+    for (std::size_t i = 0; i + 1 < operand.count; ++i) {
+      f(terms[i]);
+    }
+    if (operand.oper == Token::Kind::kEnd) {
+      lhs = terms + operand.count - 1;
+    } else if (operand.oper == Token::Kind::kEqual) {
+      rhs = terms + operand.count - 1;
+    } else {
+      f(terms[operand.count - 1]);
+    }
+  }
+  f(*rhs);
+  f(*lhs);
+}
+
+/// @brief parse an operand into scratch: the terms it folds, then its own
+/// value as the operator before it folds it
+bool Incremental::parse(const Operand& operand, std::string_view text,
+                        const bool last) {
+  Status status{};
+  Term   value{};
+
+  scratch.clear();
+  par.stream(text);
+  if (!par.operand(rpn, operand.transposed, scratch, value, status)) {
+    return false;
+  }
+  if (operand.oper == Token::Kind::kEnd) {
+    value = rpn.evaluated(Token::Kind::kEqual, value, status);
+  } else {
+    value = rpn.folded(operand.oper, value, status);
+  }
+  scratch.push_back(value);
+  // a lone "0" is only a term at the end of the equation
+  return !status && (last || std::none_of(scratch.begin(), scratch.end(),
+                                          [](const Term& term) {
+                                            return !term.getVar();
+                                          }));
+}
+
+/// @brief split the equation into operands and reduce each of them
+bool Incremental::rebuild(std::string_view equation) {
+  char        previous{' '};
+  std::size_t begin{0};
+  Token::Kind oper{Token::Kind::kEnd};
+
+  // update keeps the names, which the terms of unchanged operands refer to
+  symbols::reset();
+  operands.clear();
+  folds.clear();
+  // a group spans operands, and is multiplied out as a whole
+  if (std::count(equation.begin(), equation.end(), '=') != 1 ||
+      equation.find_first_of("()") != std::string_view::npos) {
+    return false;
+  }
+  for (std::size_t i = 0; i <= equation.size(); ++i) {
+    const bool end = i == equation.size();
+    const char ch = end ? '\0' : equation[i];
+
+    if (end || separates(ch, previous)) {
+      const Operand operand{
+          begin, i, folds.size(), 0, oper, oper == Token::Kind::kEqual ||
+                                               (!operands.empty() &&
+                                                operands.back().transposed)};
+
+      if (!parse(operand, equation.substr(begin, i - begin), end)) {
+        return false;
+      }
+      operands.push_back(operand);
+      operands.back().count = scratch.size();
+      folds.insert(folds.end(), scratch.begin(), scratch.end());
+      oper = Token::Kind{ch};
+      begin = i + 1;
+    }
+    if (ch != ' ') {
+      previous = ch;
+    }
+  }
+  line.assign(equation);
+  sum();
+  return true;
+}
+
+/// @brief reduce every term again
+void Incremental::sum() {
+  rpn.terms.clear();
+  forEachInOrder([this](const Term& term) { rpn.addTerm(term); });
+}
+
+/// @brief reduce the edit of one operand: parse it again and sum the
+/// coefficients of its old and new terms again
+/// @return false if the edit is not within one operand
+bool Incremental::update(std::string_view equation) {
+  const std::string_view previous{line};
+  const std::size_t      shorter = std::min(previous.size(), equation.size());
+  const std::size_t      prefix = static_cast<std::size_t>(
+      std::mismatch(equation.begin(), equation.begin() + shorter,
+                    previous.begin())
+          .first -
+      equation.begin());
+  std::size_t suffix{0};
+
+  if (prefix == shorter && previous.size() == equation.size()) {
+    return true;
+  }
+  while (suffix < shorter - prefix &&
+         previous[previous.size() - 1 - suffix] ==
+             equation[equation.size() - 1 - suffix]) {
+    ++suffix;
+  }
+  const std::size_t old_end = previous.size() - suffix;
+  const std::size_t new_end = equation.size() - suffix;
+
+  if (hasOperator(previous.substr(prefix, old_end - prefix)) ||
+      hasOperator(equation.substr(prefix, new_end - prefix))) {
+    return false;
+  }
+  const auto found = std::upper_bound(
+      operands.begin(), operands.end(), prefix,
+      [](const std::size_t offset, const Operand& operand) {
+        return offset < operand.begin;
+      });
+  if (found == operands.begin() || old_end > std::prev(found)->end) {
+    return false;
+  }
+  Operand&      operand = *std::prev(found);
+  const Operand edited{operand.begin, operand.end + new_end - old_end,
+                       operand.first, operand.count,
+                       operand.oper,  operand.transposed};
+
+  if (!parse(edited, equation.substr(edited.begin, edited.end - edited.begin),
+             &operand == &operands.back())) {
+    return false;
+  }
+  const auto old_terms = folds.begin() + operand.first;
+
+  keys.clear();
+  for (auto it = old_terms; it != old_terms + operand.count; ++it) {
+    keys.emplace_back(it->getVar(), it->getExp());
+  }
+  for (const Term& term : scratch) {
+    keys.emplace_back(term.getVar(), term.getExp());
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  folds.erase(old_terms, old_terms + operand.count);
+  folds.insert(folds.begin() + operand.first, scratch.begin(), scratch.end());
+  for (auto it = found; it != operands.end(); ++it) {
+    it->begin += new_end - old_end;
+    it->end += new_end - old_end;
+    it->first = it->first + scratch.size() - operand.count;
+  }
+  operand.end = edited.end;
+  operand.count = scratch.size();
+  line.replace(prefix, old_end - prefix,
+               equation.substr(prefix, new_end - prefix));
+  resum();
+  return true;
+}
+
+/// @brief sum the coefficients in keys again, from all their terms in the
+/// order reduce folds them, and replace them in the reduced form
+void Incremental::resum() {
+  sums.assign(keys.size(), 0.0);
+  forEachInOrder([this](const Term& term) {
+    const Polynomial::key_t key{term.getVar(), term.getExp()};
+    const auto found = std::lower_bound(keys.begin(), keys.end(), key);
+
+    if (found != keys.end() && *found == key && term.getCoe()) {
+      sums[static_cast<std::size_t>(found - keys.begin())] += term.getCoe();
+    }
+  });
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    Term term{sums[i]};
+
+    term.setVar(keys[i].first);
+    term.setExp(keys[i].second);
+    rpn.terms.set(term);
+  }
+}
@@ -1,5 +1,14 @@
 #include "interpreter.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "stats.h"
+#include "symbols.h"
+#include "writer.h"
+
 /* Helper functions */
 
 void printTerms(const std::vector<Term>& terms) {
@@ -7,161 +16,425 @@ void printTerms(const std::vector<Term>& terms) {
   for (const auto& term : terms) {
     std::cout << "[ " << term.getCoe();
     if (term.getVar()) {
-      std::cout << " * " << term.getVar() << " ^ " << term.getExp();
+      std::cout << " * " << symbols::name(term.getVar()) << " ^ " << term.getExp();
     }
     std::cout << " ]\n";
   }
 }
 
-int getDegree(const std::map<std::pair<char, int>, Term>& terms) {
+/// @brief the last term in variable and exponent order
+Term lastTerm(const Polynomial& terms) {
+  Term last{};
+
+  terms.forEach([&last](const Term& term) { last = term; });
+  return last;
+}
+
+int getDegree(const Polynomial& terms) {
   if (terms.empty()) {
     throw std::invalid_argument("no terms provided");
   }
   int highest{0};
 
-  for (const auto& term : terms) {
-    if (term.second.getExp() > highest) highest = term.second.getExp();
-  }
+  terms.forEach([&highest](const Term& term) {
+    if (term.getExp() > highest) highest = term.getExp();
+  });
   return highest;
 }
 
-bool sameVars(const std::map<std::pair<char, int>, Term>& terms) {
+bool sameVars(const Polynomial& terms) {
   if (terms.empty()) {
     throw std::invalid_argument("no terms provided");
   }
-  const auto check = terms.rbegin()->second;
+  const auto check = lastTerm(terms);
+  bool       same{true};
 
   if (!isConstant(check)) {
-    for (const auto& term : terms) {
-      if (!isConstant(term.second) && !sameVars(term.second, check)) {
-        return false;
+    terms.forEach([&check, &same](const Term& term) {
+      if (!isConstant(term) && !sameVars(term, check)) {
+        same = false;
       }
-    }
+    });
   }
-  return true;
+  return same;
 }
 
-bool validDegree(const std::map<std::pair<char, int>, Term>& terms) {
-  constexpr int max_degree = 2;
-  constexpr int min_degree = 0;
-
-  int degree = getDegree(terms);
-  if (degree > max_degree || min_degree > degree) {
-    return false;
-  }
-  return true;
-}
-
-bool solvable(const std::map<std::pair<char, int>, Term>& terms) {
+/// @brief why the reduced form can not be solved, kNone if it can
+Errc solvable(const Polynomial& terms) {
   if (terms.empty()) {
-    throw std::invalid_argument("no terms provided");
+    return Errc::kNoTerms;
   }
-  if (!validDegree(terms)) {
-    throw std::invalid_argument(
-        "can not solve equation with a degree higher than 2");
+  if (getDegree(terms) > utils::max_solved_degree) {
+    return Errc::kSolveDegreeTooBig;
   }
   if (!sameVars(terms)) {
-    throw std::invalid_argument(
-        "can not solve equation with different variables");
+    return Errc::kDifferentVariables;
   }
-  return true;
+  return Errc::kNone;
 }
 
-void printReducedForm(const std::map<std::pair<char, int>, Term>& terms) {
+/// @brief throw the error a status-reporting overload ran into
+void raiseIf(const Status& status) {
+  if (status) {
+    status.raise();
+  }
+}
+
+void printReducedForm(const Polynomial& terms, Writer& out) {
   if (terms.empty()) {
     throw std::invalid_argument("no terms provided");
   }
+  bool first{true};
 
-  std::cout << "Reduced form: ";
-  for (auto it = terms.begin(); it != terms.end(); ++it) {
-    if (it == terms.begin()) {
-      std::cout << it->second << " ";
-    } else if (it->second > 0) {
-      std::cout << "+ " << it->second << " ";
-    } else if (it->second < 0) {
-      std::cout << "- " << -(it->second) << " ";
+  out << "Reduced form: ";
+  terms.forEach([&first, &out](const Term& term) {
+    if (first) {
+      out << term << " ";
+    } else if (term > 0) {
+      out << "+ " << term << " ";
+    } else if (term < 0) {
+      out << "- " << -term << " ";
     }
-  }
-  std::cout << "= 0\n";
+    first = false;
+  });
+  out << "= 0\n";
 }
 
 /* Interpreter */
 
-Interpreter::Interpreter(Tree& t) : tree{} {
-  tree.setRoot(std::move(t.getRoot()));
+Interpreter::Interpreter() : solutions{}, convergence{}, rpn{}, tree{} {}
+
+Interpreter::Interpreter(Tree& t) : solutions{}, convergence{}, rpn{}, tree{} {
+  tree.swap(t);
 }
 
-/// @brief move quantities from the right hand side of the equation across
-void Interpreter::transpose() {
-  if (!std::holds_alternative<BinaryExpr>(*tree.getRoot())) {
-    throw std::invalid_argument("expression is not an equation");
+/// @brief forget the previous equation, keeping the capacity of its terms
+/// and solutions for the next one
+void Interpreter::clear() {
+  solutions.clear();
+  rpn.terms.clear();
+}
+
+/// @brief forget the previous equation and take t in its place; t gets the
+/// previous tree back, so both keep their capacity for the next equation
+void Interpreter::reset(Tree& t) {
+  clear();
+  tree.swap(t);
+}
+
+/// @brief forget the previous equation and take a reduced form in its place,
+/// coefficients in ascending order of exponent
+void Interpreter::load(const char var, const double* coefficients,
+                       const std::size_t count) {
+  clear();
+  for (std::size_t exp = 0; exp < count; ++exp) {
+    if (coefficients[exp]) {
+      rpn.addTerm(Term{coefficients[exp], var, static_cast<int>(exp)});
+    }
   }
-  std::visit(TransposeVisitor{}, *std::get<BinaryExpr>(*tree.getRoot()).right);
 }
 
-Interpreter::solutions_t Interpreter::getSolutions() const { return solutions; }
+/// @brief take a reduced form built elsewhere, e.g. by Incremental
+void Interpreter::load(const Polynomial& reduced) {
+  solutions.clear();
+  rpn.terms = reduced;
+}
 
-/// @brief if present, variable is at last element of the map (rbegin)
-char Interpreter::findVar() const {
-  const auto found = rpn.terms.rbegin();
+/// @brief stopping criteria for equations above degree 2
+void Interpreter::setConvergence(const utils::Convergence& c) {
+  convergence = c;
+}
 
-  if (found != rpn.terms.rend()) {
-    return found->second.getVar();
+/// @brief move quantities from the right hand side of the equation across
+void Interpreter::transpose() {
+  const stats::Timer timer{stats::Stage::kTranspose};
+
+  if (tree.empty() || tree.node(tree.getRoot()).oper != Token::Kind::kEqual) {
+    stats::error(Errc::kNotEquation);
+    throw std::invalid_argument("expression is not an equation");
   }
-  return 0;
+  TransposeVisitor{}(tree);
 }
 
+const Interpreter::solutions_t& Interpreter::getSolutions() const {
+  return solutions;
+}
+
+/// @brief if present, variable is at the last term
+char Interpreter::findVar() const { return lastTerm(rpn.terms).getVar(); }
+
 /// @brief find the coefficient of the corresponding variable and exponent
 double Interpreter::findCoef(const char var, const int exp) const {
-  const auto found = rpn.terms.find(std::make_pair(var, exp));
+  return rpn.terms.find(var, exp);
+}
+
+/// @brief true if every term cancelled out during reduction
+bool Interpreter::allReals() const { return rpn.terms.empty(); }
+
+/// @brief transpose the equation and fold its terms into the reduced form
+void Interpreter::reduce() {
+  transpose();
 
-  if (found != rpn.terms.end()) {
-    return found->second.getCoe();
+  const stats::Timer timer{stats::Stage::kReduce};
+
+  rpn(tree);
+  if (stats::enabled()) {
+    stats::count(stats::Counter::kTerms, rpn.terms.size());
   }
-  return 0;
 }
 
-/// @brief evaluate the equation
-void Interpreter::evaluate() {
+/// @brief fold the parser's input straight into the reduced form, without
+/// building a tree
+/// @return false if the user asked to quit
+bool Interpreter::reduce(Parser& par) { return par.reduce(rpn); }
+
+/// @brief same as reduce, reporting any error in status
+/// @return false if the user asked to quit or on error
+bool Interpreter::reduce(Parser& par, Status& status) {
+  return par.reduce(rpn, status);
+}
+
+/// @brief solve the reduced form without printing anything
+void Interpreter::solve() {
+  Status status{};
+
+  solve(status);
+  raiseIf(status);
+}
+
+/// @brief same as solve, reporting any error in status
+void Interpreter::solve(Status& status) {
+  const stats::Timer timer{stats::Stage::kSolve};
+
+  solveReduced(status);
+  stats::error(status.code);
+}
+
+/// @brief solve without the cache, untimed
+void Interpreter::solveReduced(Status& status) {
   constexpr int exponent_two = 2;
   constexpr int exponent_one = 1;
   constexpr int exponent_none = 0;
 
-  transpose();
-  if (!std::holds_alternative<BinaryExpr>(*tree.getRoot())) {
-    throw grammarError("expression is not an equation (ex. 42 * X^2 = 0)");
+  if (allReals()) {
+    return;
+  }
+  status = {solvable(rpn.terms)};
+  if (status) {
+    return;
   }
+  char      var = findVar();
+  const int degree = getDegree(rpn.terms);
 
-  rpn.evaluate((std::get<BinaryExpr>(*tree.getRoot())),
-               std::visit(rpn, *tree.getRoot()));
+  if (degree > exponent_two) {
+    return solvePolynomial(var, degree, status);
+  }
+  double a = findCoef(var, exponent_two);
+  double b = findCoef(var, exponent_one);
+  double c = findCoef(var, exponent_none);
 
-  if (rpn.terms.empty()) {
-    std::cout << "The solution is:\nAll real numbers\n";
+  if (!a && !b) {
+    status = {Errc::kZeroSlope};
     return;
+  } else if (!a) {
+    solutions.emplace_back(utils::linear_equation_solver(b, c));
+  } else {
+    utils::quadratic_equation_solver(a, b, c, solutions);
+  }
+  if (solutions.empty()) {
+    status = {Errc::kNoSolution};
   }
+}
+
+/// @brief solve the reduced form through a cache, which skips the solvers
+/// for any reduced form it has seen, whatever its variable
+void Interpreter::solve(SolutionCache& cache) {
+  Status status{};
 
-  printReducedForm(rpn.terms);
-  std::cout << "Polynomial degree: " << getDegree(rpn.terms) << '\n';
-  solvable(rpn.terms);
+  solve(cache, status);
+  raiseIf(status);
+}
 
+/// @brief same as solve through a cache, reporting any error in status
+void Interpreter::solve(SolutionCache& cache, Status& status) {
+  constexpr int exponent_two = 2;
+  constexpr int exponent_one = 1;
+  constexpr int exponent_none = 0;
+
+  const stats::Timer timer{stats::Stage::kSolve};
+
+  if (allReals()) {
+    return;
+  }
+  status = {solvable(rpn.terms)};
+  if (status) {
+    stats::error(status.code);
+    return;
+  }
   char   var = findVar();
   double a = findCoef(var, exponent_two);
   double b = findCoef(var, exponent_one);
   double c = findCoef(var, exponent_none);
 
-  if (!a) {
-    solutions.emplace_back(utils::linear_equation_solver(b, c));
-  } else {
-    solutions = utils::quadratic_equation_solver(a, b, c);
+  if (getDegree(rpn.terms) > exponent_two || (!a && !b)) {
+    solveReduced(status);
+    stats::error(status.code);
+    return;
   }
-  if (solutions.empty()) {
-    throw std::runtime_error("no solution available\n");
-  } else if (solutions.size() == 1) {
-    std::cout << "The solution is:\n";
-  } else if (solutions.size() == 2) {
-    std::cout << "The solutions are:\n";
-  }
-  for (int i = 0; i < solutions.size(); ++i) {
-    std::visit(utils::ComplexVisitor{}, solutions.at(i));
+  const SolutionCache::Key key = SolutionCache::key(a, b, c);
+
+  if (cache.find(key, solutions)) {
+    return;
+  }
+  solutions = SolutionCache::solve(key);
+  cache.insert(key, solutions);
+}
+
+/// @brief solve a reduced form above degree 2 with the Aberth iteration.
+/// A root is real where its error disc meets the real axis, which also
+/// catches the multiple real roots the iteration only finds to about
+/// eps^(1/m), as pairs a little off the axis. The other roots are matched
+/// into conjugate pairs, as those of a real polynomial are, and each pair
+/// is made exactly conjugate. Roots are sorted by real part, then by
+/// imaginary part, so a pair prints its negative part first.
+void Interpreter::solvePolynomial(const char var, const int degree,
+                                  Status& status) {
+  // imaginary parts this small, relative to the root, are rounding errors
+  // even where the error bound is tighter
+  constexpr double real_threshold{1e-10};
+
+  std::vector<double> coefficients(degree + 1);
+
+  for (int exp = 0; exp <= degree; ++exp) {
+    coefficients[exp] = findCoef(var, exp);
+  }
+  utils::PolynomialRoots roots =
+      utils::polynomial_roots(coefficients, convergence);
+
+  if (!roots.converged) {
+    status = {Errc::kNoConvergence};
+    return;
+  }
+  const std::size_t        n = roots.real.size();
+  std::vector<std::size_t> upper;
+  std::vector<std::size_t> lower;
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const double imag = std::abs(roots.imag[i]);
+
+    roots.real[i] += 0.0;
+    if (imag <= roots.error[i] ||
+        imag <= real_threshold *
+                    std::max(1.0, std::hypot(roots.real[i], imag))) {
+      roots.imag[i] = 0;
+    } else {
+      (roots.imag[i] > 0 ? upper : lower).push_back(i);
+    }
+  }
+  // the nearest conjugate of each root above the axis, among those below
+  for (const std::size_t i : upper) {
+    auto   nearest = lower.end();
+    double distance{std::numeric_limits<double>::infinity()};
+
+    for (auto it = lower.begin(); it != lower.end(); ++it) {
+      const double d = std::hypot(roots.real[i] - roots.real[*it],
+                                  roots.imag[i] + roots.imag[*it]);
+
+      if (d < distance) {
+        distance = d;
+        nearest = it;
+      }
+    }
+    if (nearest == lower.end()) {
+      break;
+    }
+    const std::size_t j = *nearest;
+    const double      real = (roots.real[i] + roots.real[j]) / 2 + 0.0;
+    const double      imag = (roots.imag[i] - roots.imag[j]) / 2;
+
+    roots.real[i] = real;
+    roots.real[j] = real;
+    roots.imag[i] = imag;
+    roots.imag[j] = -imag;
+    lower.erase(nearest);
+  }
+  std::vector<std::size_t> order(n);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&roots](const auto l, const auto r) {
+    return std::pair{roots.real[l], roots.imag[l]} <
+           std::pair{roots.real[r], roots.imag[r]};
+  });
+  for (const std::size_t i : order) {
+    if (roots.imag[i]) {
+      solutions.emplace_back(utils::Complex{roots.real[i], roots.imag[i]});
+    } else {
+      solutions.emplace_back(roots.real[i]);
+    }
+  }
+}
+
+/// @brief print the reduced form and its degree
+/// @return false if every term cancelled out, which is printed as well
+bool Interpreter::describe(Writer& out) {
+  const stats::Lap print{stats::Stage::kPrint};
+
+  if (allReals()) {
+    out << "The solution is:\nAll real numbers\n";
+    return false;
+  }
+  printReducedForm(rpn.terms, out);
+  out << "Polynomial degree: " << getDegree(rpn.terms) << '\n';
+  return true;
+}
+
+/// @brief print the solutions found by solve
+void Interpreter::printSolutions(Writer& out) const {
+  const stats::Lap print{stats::Stage::kPrint};
+
+  if (solutions.size() == 1) {
+    out << "The solution is:\n";
+  } else if (solutions.size() >= 2) {
+    out << "The solutions are:\n";
+  }
+  for (const auto& solution : solutions) {
+    std::visit([&out](const auto& root) { out << root << '\n'; }, solution);
+  }
+  out.flush();
+}
+
+/// @brief evaluate the equation
+void Interpreter::evaluate() {
+  reduce();
+  evaluateReduced();
+}
+
+/// @brief evaluate the equation, solving it through a cache
+void Interpreter::evaluate(SolutionCache& cache) {
+  reduce();
+  evaluateReduced(cache);
+}
+
+/// @brief evaluate the reduced form given to load, without a tree
+void Interpreter::evaluateReduced() {
+  const stats::Total print{stats::Stage::kPrint};
+  Writer             out{std::cout};
+
+  if (describe(out)) {
+    solve();
+    printSolutions(out);
+  }
+}
+
+/// @brief same, solving through a cache
+void Interpreter::evaluateReduced(SolutionCache& cache) {
+  const stats::Total print{stats::Stage::kPrint};
+  Writer             out{std::cout};
+
+  if (describe(out)) {
+    solve(cache);
+    printSolutions(out);
   }
 }
@@ -1,64 +1,161 @@
 #include "lexer.h"
 
+#include <cctype>
+#include <charconv>
+#include <string>
+#include <system_error>
+
+#include "stats.h"
+#include "symbols.h"
+
 /* Lexer */
 
-Lexer::Lexer() : scanner{}, buffer{}, ready{false}, full{false} {}
+Lexer::Lexer() : input{}, position{0}, buffer{}, ready{false}, full{false} {}
 
-Lexer::Lexer(const std::string &s)
-    : scanner{s}, buffer{}, ready{true}, full{false} {}
+Lexer::Lexer(std::string_view s)
+    : input{s}, position{0}, buffer{}, ready{true}, full{false} {}
 
-void Lexer::stream(const std::string &s) {
-  scanner = std::istringstream{s};
+void Lexer::stream(std::string_view s) {
+  input = s;
+  position = 0;
   full = false;
   ready = true;
 }
 
-Token Lexer::number() {
-  double d{0};
-  scanner.unget();
-  scanner >> d;
-  return Token{Token::Kind::kNumber, d};
+/// @brief scan "<int>", "<int>." or "<int>.<int>" starting at the current
+/// position. std::from_chars is locale independent and never allocates.
+Token Lexer::number(Status& status) {
+  const std::size_t start{position};
+  const char*       first = input.data() + position;
+  double            d{0};
+
+  const auto [last, error] = std::from_chars(
+      first, input.data() + input.size(), d, std::chars_format::fixed);
+  position += static_cast<std::size_t>(last - first);
+  if (error == std::errc::result_out_of_range) {
+    const std::string_view digits{first,
+                                  static_cast<std::size_t>(last - first)};
+    const auto integral = digits.substr(0, digits.find('.'));
+
+    status = {integral.find_first_not_of('0') != std::string_view::npos
+                  ? Errc::kNumberOverflow
+                  : Errc::kNumberUnderflow,
+              start};
+    return Token{Token::Kind::kEnd, std::monostate{}, start};
+  } else if (error != std::errc{}) {
+    status = {Errc::kInvalidNumber, start};
+    return Token{Token::Kind::kEnd, std::monostate{}, start};
+  }
+  return Token{Token::Kind::kNumber, d, start};
+}
+
+/// @brief scan a run of letters: the quit command when it is only "q", a
+/// variable of one or more of them otherwise
+Token Lexer::identifier(Status& status) {
+  const std::size_t start{position};
+
+  while (position < input.size() &&
+         std::isalpha(static_cast<unsigned char>(input[position]))) {
+    ++position;
+  }
+  const std::string_view name{input.substr(start, position - start)};
+
+  if (name == "q") {
+    return Token{Token::Kind::kQuit, 'q', start};
+  }
+  const symbols::symbol_t symbol = symbols::intern(name, status);
+
+  if (status) {
+    status.offset = start;
+    return Token{Token::Kind::kEnd, std::monostate{}, start};
+  }
+  return Token{Token::Kind::kVariable, symbol, start};
 }
 
 bool Lexer::isReady() const { return ready; }
 
+/// @brief true if a "(" comes before the end of the operand being lexed:
+/// the next "=", or "+" or "-" after a digit or a point. Terms end with a
+/// number, so a sign after one is binary, and unary anywhere else.
+bool Lexer::groupAhead() const {
+  char previous{' '};
+
+  if (full && buffer.kind == Token::Kind::kOpen) {
+    return true;
+  } else if (full && buffer.kind == Token::Kind::kNumber) {
+    previous = '0';
+  }
+  for (std::size_t i = position; i < input.size(); ++i) {
+    const char ch = input[i];
+
+    if (ch == '(') {
+      return true;
+    } else if (ch == '=' ||
+               ((ch == '+' || ch == '-') &&
+                (std::isdigit(static_cast<unsigned char>(previous)) ||
+                 previous == '.'))) {
+      return false;
+    } else if (ch != ' ') {
+      previous = ch;
+    }
+  }
+  return false;
+}
+
 Token Lexer::get(void) {
+  Status status{};
+  Token  token = get(status);
+
+  if (status) {
+    status.raise();
+  }
+  return token;
+}
+
+/// @brief the next token; on error, an end token and the error in status
+Token Lexer::get(Status& status) {
   if (!isReady()) {
-    throw std::invalid_argument("can not tokenize empty input string");
+    status = {Errc::kEmptyInput, position};
+    return Token{Token::Kind::kEnd, std::monostate{}, position};
   }
   if (full) {
     full = false;
     return buffer;
   }
+  const stats::Lexing lexing{};
+
+  while (position < input.size()) {
+    const std::size_t start{position};
+    const char        ch = input[position];
 
-  for (;;) {
-    char ch = scanner.get();
     switch (ch) {
       case ' ':
+        ++position;
         continue;
-      case 'q':
       case '+':
       case '-':
       case '*':
       case '/':
       case '^':
       case '=':
-        return Token{Token::Kind{ch}, {ch}};
+      case '(':
+      case ')':
+        ++position;
+        return Token{Token::Kind{ch}, {ch}, start};
       default: {
-        if (std::isdigit(ch)) {
-          return number();
-        } else if (std::isalpha(ch)) {
-          return Token{Token::Kind::kVariable, ch};
-        } else if (scanner.eof()) {
-          return Token{Token::Kind::kEnd};
+        if (std::isdigit(static_cast<unsigned char>(ch))) {
+          return number(status);
+        } else if (std::isalpha(static_cast<unsigned char>(ch))) {
+          return identifier(status);
         } else {
           ready = false;
-          throw grammarError(std::string{"character not supported: "} +
-                             std::string{ch});
+          status = {Errc::kUnsupportedCharacter, start, ch};
+          return Token{Token::Kind::kEnd, std::monostate{}, start};
         }
       }
     }
   }
+  return Token{Token::Kind::kEnd, std::monostate{}, position};
 }
 
 void Lexer::putback(Token token) {
@@ -71,9 +168,24 @@ void Lexer::putback(Token token) {
 }
 
 Token Lexer::peek(void) {
+  Status status{};
+  Token  token = peek(status);
+
+  if (status) {
+    status.raise();
+  }
+  return token;
+}
+
+/// @brief the next token without consuming it; errors are not buffered
+Token Lexer::peek(Status& status) {
   if (full) {
     return buffer;
   }
-  putback(get());
-  return buffer;
+  const Token token = get(status);
+
+  if (!status) {
+    putback(token);
+  }
+  return token;
 }
@@ -1,25 +1,199 @@
-#include <cmath>
+#include <algorithm>
+#include <csignal>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
 
+#include "batch.h"
+#include "binary.h"
+#include "cache.h"
+#include "diskcache.h"
 #include "interpreter.h"
 #include "parser.h"
+#include "repl.h"
+#include "server.h"
+#include "stats.h"
+#include "writer.h"
+
+namespace {
+
+constexpr std::string_view usage{
+    "usage: ./computorv1 [--stats] [--round-trip] [--cache-file <path>] "
+    "[equation | --batch <file> [--jobs <n>] | --serve <socket> [--jobs <n>]]"
+    "\n       ./computorv1 [--stats] [--round-trip] --binary <file>"};
+
+/// @brief parse the worker count of --jobs
+unsigned jobs(const std::string_view arg) {
+  const int count = std::stoi(std::string{arg});
+
+  if (count < 1) {
+    throw std::invalid_argument("--jobs must be at least 1");
+  }
+  return static_cast<unsigned>(count);
+}
+
+/// @brief remove "name <value>" from the arguments
+/// @return the value, empty if the option is absent
+std::string option(std::vector<std::string_view> &args,
+                   const std::string_view    name) {
+  for (std::size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == name) {
+      if (i + 1 == args.size()) {
+        throw std::invalid_argument(std::string{usage});
+      }
+      std::string value{args[i + 1]};
+
+      args.erase(args.begin() + i, args.begin() + i + 2);
+      return value;
+    }
+  }
+  return {};
+}
+
+/// @brief remove "name" from the arguments
+/// @return true if the flag was present
+bool flag(std::vector<std::string_view> &args, const std::string_view name) {
+  const auto found = std::find(args.begin(), args.end(), name);
+
+  if (found == args.end()) {
+    return false;
+  }
+  args.erase(found);
+  return true;
+}
+
+/// @brief prints the --stats summary to stderr when main returns
+class Summary {
+ public:
+  Summary(const bool requested, const std::optional<SolutionCache> &c)
+      : rejected{}, enabled{requested}, cache{c} {
+    stats::enable(enabled);
+  }
+  ~Summary() {
+    if (!enabled) {
+      return;
+    }
+    stats::report(std::cerr);
+    if (cache && cache->hits() + cache->misses()) {
+      std::cerr << "cache: hits " << cache->hits() << ", misses "
+                << cache->misses() << ", disk hits " << cache->diskHits()
+                << '\n';
+    }
+    if (rejected) {
+      std::cerr << "server: rejected " << *rejected << '\n';
+    }
+  }
+
+  std::optional<std::size_t> rejected;
+
+ private:
+  Summary(const Summary &) = delete;
+  Summary &operator=(const Summary &) = delete;
+
+  bool                                enabled;
+  const std::optional<SolutionCache> &cache;
+};
+
+}  // namespace
 
 int main(int argc, char *argv[]) try {
-  Parser par;
+  Parser                        par;
+  std::vector<std::string_view> args{argv + 1, argv + argc};
+  const bool                    stats_requested = flag(args, "--stats");
+  const bool                    round_trip = flag(args, "--round-trip");
+  const std::string             cache_file = option(args, "--cache-file");
+  std::unique_ptr<DiskCache>    disk;
+  std::optional<SolutionCache>  cache;
+  Summary                       summary{stats_requested, cache};
+
+  if (round_trip) {
+    Writer::setFormat(Writer::Format::kShortest);
+  }
+  // binary records are solved a chunk at a time by the vectorised solver,
+  // which no cache sits in front of
+  if (!cache_file.empty() && !args.empty() && args[0] == "--binary") {
+    throw std::invalid_argument("--cache-file can not be used with --binary");
+  }
+  if (cache_file.empty()) {
+    cache.emplace(batch::cache_entries);
+  } else {
+    disk = std::make_unique<DiskCache>(cache_file, DiskCache::default_slots);
+    cache.emplace(batch::cache_entries, *disk);
+  }
+  if (!args.empty() && args[0] == "--batch") {
+    if (args.size() != 2 && !(args.size() == 4 && args[2] == "--jobs")) {
+      throw std::invalid_argument(std::string{usage});
+    }
+    batch::MappedFile file{std::string{args[1]}};
+
+    std::ios::sync_with_stdio(false);
+    batch::run(file.view(), std::cout, args.size() == 4 ? jobs(args[3]) : 1,
+               *cache);
+    std::cout.flush();
+    return 0;
+  } else if (!args.empty() && args[0] == "--binary") {
+    if (args.size() != 2) {
+      throw std::invalid_argument(std::string{usage});
+    }
+    batch::MappedFile file{std::string{args[1]}};
+
+    std::ios::sync_with_stdio(false);
+    binary::run(file.view(), std::cout);
+    std::cout.flush();
+    return 0;
+  } else if (!args.empty() && args[0] == "--serve") {
+    if (args.size() != 2 && !(args.size() == 4 && args[2] == "--jobs")) {
+      throw std::invalid_argument(std::string{usage});
+    }
+    sigset_t signals;
+
+    // block the shutdown signals before any thread starts, so only the
+    // waiting thread below receives them
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
 
-  std::cerr << std::fixed << (std::pow(2, 62)) << '\n';
-  double lol = utils::exponentiation(2, 63);
+    server::Server serve{
+        std::string{args[1]},
+        args.size() == 4 ? jobs(args[3])
+                         : std::max(1u, std::thread::hardware_concurrency()),
+        *cache};
 
-  if (argc == 1) {
-    par.stream(par.prompt());
-  } else if (argc == 2) {
-    par.stream(argv[1]);
+    std::thread{[&serve, signals] {
+      int signal{0};
+
+      sigwait(&signals, &signal);
+      serve.stop();
+    }}.detach();
+    serve.run();
+    summary.rejected = serve.rejected();
+    return 0;
+  } else if (args.empty()) {
+    if (disk) {
+      Repl{*cache}.run();
+    } else {
+      Repl{}.run();
+    }
+    return 0;
+  } else if (args.size() == 1) {
+    par.stream(args[0]);
   } else {
-    throw(std::invalid_argument("usage: ./computorv1 [equation]"));
+    throw(std::invalid_argument(std::string{usage}));
+  }
+  if (!par.parse()) {
+    std::cout << "quiting computorv1\n";
+    return 0;
   }
-  if (!par.parse()) return 0;
 
   Interpreter interp(par.getTree());
-  interp.evaluate();
+  if (disk) {
+    interp.evaluate(*cache);
+  } else {
+    interp.evaluate();
+  }
   return 0;
 } catch (std::exception &e) {
   std::cerr << e.what();
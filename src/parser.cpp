@@ -1,5 +1,12 @@
 #include "parser.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "expansion.h"
+#include "stats.h"
+
 /*
 
 A parser really has two jobs:
@@ -21,10 +28,18 @@ https://mdkrajnak.github.io/ebnftest/
 
 <equation> ::= <expression> "=" <expression> | <expression>
 <expression> ::= <expression> "-" <factor> | <expression> "+" <factor> | <factor>
-<factor> ::= <factor> "*" <power> | <factor> "/" <power> | <power>
+<factor> ::= <factor> "*" <power> | <factor> "/" <power> | <power> | <product>
 <power> ::= <power> "^" <int> | <unary>
 <unary> ::= "-" <term> | <term>
 <term> ::= <num> "*" <var> "^" <int> | <num>
+
+A factor with a parenthesis is multiplied out instead:
+
+<product> ::= <product> "*" <negation> | <product> "/" <negation> | <negation>
+<negation> ::= "-" <negation> | <exponentiation>
+<exponentiation> ::= <exponentiation> "^" <int> | <primary>
+<primary> ::= "(" <sum> ")" | <num> | <var>
+<sum> ::= <sum> "+" <product> | <sum> "-" <product> | <product>
 <num> ::= <int> | <float>
 <float> ::= <int> "." <int> | <int> "."
 <int> ::= <int> <digit> | <digit>
@@ -34,137 +49,570 @@ https://mdkrajnak.github.io/ebnftest/
 
 // clang-format on
 
+/* Builders */
+
+namespace {
+
+/// @brief emits the syntax tree in post-order
+class TreeBuilder {
+ public:
+  using value_t = Tree::index_t;
+
+  TreeBuilder(Tree& t) : tree{t} {}
+
+  value_t term(const Term& term) { return tree.term(term); }
+  value_t unary(Token::Kind oper, const value_t child) {
+    return tree.unary(oper, child);
+  }
+  value_t binary(Token::Kind oper, const value_t left, const value_t right) {
+    return tree.binary(oper, left, right);
+  }
+  void transpose() {}
+
+ private:
+  Tree& tree;
+};
+
+/// @brief folds every term into the reduced form as soon as it is parsed.
+/// Produces the same terms as transposing and reducing the tree, but only
+/// keeps one term per nesting level instead of the whole tree.
+class Reducer {
+ public:
+  using value_t = Term;
+
+  Reducer(RpnVisitor& r, Status& s) : rpn{r}, status{s}, transposed{false} {}
+
+  value_t term(Term term) {
+    if (transposed) {
+      TransposeVisitor{}(term);
+    }
+    return term;
+  }
+  value_t unary(Token::Kind oper, const value_t& child) {
+    return rpn.unary(oper, child, status);
+  }
+  value_t binary(Token::Kind oper, const value_t& left, const value_t& right) {
+    rpn.fold(oper, right, status);
+    return left;
+  }
+  void transpose() { transposed = true; }
+  bool isEquation() const { return transposed; }
+
+ protected:
+  RpnVisitor& rpn;
+  Status&     status;
+  bool        transposed;
+};
+
+/// @brief same as Reducer, but appends the terms it would fold to a list
+/// instead, in the order it would fold them
+class Recorder : public Reducer {
+ public:
+  Recorder(RpnVisitor& r, Status& s, std::vector<Term>& f)
+      : Reducer{r, s}, folds{f} {}
+
+  value_t binary(Token::Kind oper, const value_t& left, const value_t& right) {
+    folds.push_back(rpn.folded(oper, right, status));
+    return left;
+  }
+
+ private:
+  std::vector<Term>& folds;
+};
+
+}  // namespace
+
 /* Parser */
 
-Parser::Parser() : lexer{} {}
+Parser::Parser() : lexer{}, tree{}, status{} {}
 
-Parser::Parser(const std::string& s) { lexer.stream(s); }
+Parser::Parser(std::string_view s) : lexer{}, tree{}, status{} {
+  lexer.stream(s);
+}
 
-void Parser::stream(const std::string& s) { lexer.stream(s); }
+void Parser::stream(std::string_view s) { lexer.stream(s); }
 
-Token Parser::peek() { return lexer.peek(); }
+/// @brief after an error every token is the end, which unwinds the descent
+Token Parser::peek() {
+  if (status) {
+    return Token{Token::Kind::kEnd, std::monostate{}, status.offset};
+  }
+  return lexer.peek(status);
+}
 
-Token Parser::advance() { return lexer.get(); }
+Token Parser::advance() {
+  if (status) {
+    return Token{Token::Kind::kEnd, std::monostate{}, status.offset};
+  }
+  return lexer.get(status);
+}
+
+/// @brief remember the first error of the parse
+void Parser::fail(Errc code, std::size_t offset) {
+  if (!status) {
+    status = {code, offset};
+  }
+}
 
 bool Parser::check(const Token& token, Token::Kind kind) {
   return token.kind == kind;
 }
 
 /* "[num] * [char] ^ [num]" OR "0" AND end of equation */
-std::unique_ptr<Parser::node_t> Parser::term(void) {
+template <typename Builder>
+typename Builder::value_t Parser::term(Builder& builder) {
   Term expr{};
 
   if (check(peek().kind, Token::Kind::kNumber)) {
     expr.setCoe(std::get<double>(advance().value));
   } else {
-    throw grammarError("missing number in term (ex. \"42\" * X^2)");
+    fail(Errc::kMissingNumber, peek().offset);
+    return {};
   }
   if (!expr.getCoe() && check(peek().kind, Token::Kind::kEnd)) {
-    return std::make_unique<node_t>(expr);
+    return builder.term(expr);
   }
   if (check(peek().kind, Token::Kind::kAsterisk)) {
     advance();
   } else {
-    throw grammarError("missing asterisk in term (ex. 42 \"*\" X^2)");
+    fail(Errc::kMissingAsterisk, peek().offset);
+    return {};
   }
   if (check(peek().kind, Token::Kind::kVariable)) {
     expr.setVar(std::get<char>(advance().value));
   } else {
-    throw grammarError("missing variable in term (ex. 42 * \"X\"^2)");
+    fail(Errc::kMissingVariable, peek().offset);
+    return {};
   }
   if (check(peek().kind, Token::Kind::kCaret)) {
     advance();
   } else {
-    throw grammarError("missing caret in term (ex. 42 * X\"^\"2)");
+    fail(Errc::kMissingCaret, peek().offset);
+    return {};
   }
   if (check(peek().kind, Token::Kind::kNumber)) {
     expr.setExp(std::get<double>(advance().value));
   } else {
-    throw grammarError("missing exponent in term (ex. 42 * X^\"2\")");
+    fail(Errc::kMissingExponent, peek().offset);
+    return {};
   }
-  return std::make_unique<node_t>(expr);
+  return builder.term(expr);
 }
 
-std::unique_ptr<Parser::node_t> Parser::unary(void) {
+template <typename Builder>
+typename Builder::value_t Parser::unary(Builder& builder) {
   if (check(peek(), Token::Kind::kMinus)) {
     Token::Kind current = peek().kind;
     advance();
-    std::unique_ptr<node_t> expr = unary();
-    return std::make_unique<node_t>(UnaryExpr{current, expr});
+    typename Builder::value_t expr = unary(builder);
+    if (status) {
+      return expr;
+    }
+    return builder.unary(current, expr);
   }
-  return term();
+  return term(builder);
 }
 
-std::unique_ptr<Parser::node_t> Parser::power(void) {
-  std::unique_ptr<node_t> expr = unary();
+template <typename Builder>
+typename Builder::value_t Parser::power(Builder& builder) {
+  typename Builder::value_t expr = unary(builder);
 
   while (check(peek(), Token::Kind::kCaret)) {
     Token::Kind current = peek().kind;
     advance();
-    std::unique_ptr<node_t> rhs = term();
-    expr = std::make_unique<node_t>(BinaryExpr{current, expr, rhs});
+    typename Builder::value_t rhs = term(builder);
+    if (status) {
+      return expr;
+    }
+    expr = builder.binary(current, expr, rhs);
   }
   return expr;
 }
 
-std::unique_ptr<Parser::node_t> Parser::factor(void) {
-  std::unique_ptr<node_t> expr = power();
+/* groups */
+
+namespace {
+
+/// @brief drop the zero coefficients above the degree
+void trim(std::vector<double>& coefficients) {
+  while (coefficients.size() > 1 && !coefficients.back()) {
+    coefficients.pop_back();
+  }
+}
+
+}  // namespace
+
+/// @brief give lhs the variable it shares with rhs
+/// @return false if they have different ones
+bool Parser::unite(Expansion& lhs, const Expansion& rhs,
+                   const std::size_t offset) {
+  if (lhs.var && rhs.var && lhs.var != rhs.var) {
+    fail(Errc::kUnlikeVariables, offset);
+    return false;
+  }
+  lhs.var = lhs.var ? lhs.var : rhs.var;
+  return true;
+}
+
+/// @brief divide lhs by rhs, which must be a non-zero monomial that
+/// divides it, as the result has no negative exponents
+bool Parser::divide(Expansion& lhs, const Expansion& rhs,
+                    const std::size_t offset) {
+  const std::vector<double>& divisor = rhs.coefficients;
+  const std::size_t          exp = divisor.size() - 1;
+  std::vector<double>&       dividend = lhs.coefficients;
+
+  if (!divisor[exp] || exp >= dividend.size() ||
+      std::any_of(divisor.begin(), divisor.end() - 1,
+                  [](const double coe) { return coe != 0; }) ||
+      std::any_of(dividend.begin(), dividend.begin() + exp,
+                  [](const double coe) { return coe != 0; })) {
+    fail(Errc::kIndivisible, offset);
+    return false;
+  }
+  dividend.erase(dividend.begin(), dividend.begin() + exp);
+  for (double& coe : dividend) {
+    coe /= divisor[exp];
+  }
+  return true;
+}
+
+/* "(" sum ")" OR number OR variable */
+void Parser::primary(Expansion& out) {
+  const Token token = advance();
+
+  out = {0, {0}};
+  if (check(token, Token::Kind::kNumber)) {
+    out.coefficients[0] = std::get<double>(token.value);
+  } else if (check(token, Token::Kind::kVariable)) {
+    out = {std::get<char>(token.value), {0, 1}};
+  } else if (check(token, Token::Kind::kOpen)) {
+    sum(out);
+    if (!check(peek(), Token::Kind::kClose)) {
+      fail(Errc::kMissingParenthesis, peek().offset);
+      return;
+    }
+    advance();
+  } else {
+    fail(Errc::kMissingNumber, token.offset);
+  }
+}
+
+/// @brief raise to integer powers by repeated squaring
+void Parser::exponentiation(Expansion& out) {
+  std::vector<double> base;
+
+  primary(out);
+  while (check(peek(), Token::Kind::kCaret)) {
+    advance();
+    const Token token = peek();
+
+    if (!check(token, Token::Kind::kNumber) ||
+        std::trunc(std::get<double>(token.value)) !=
+            std::get<double>(token.value)) {
+      fail(Errc::kMissingExponent, token.offset);
+      return;
+    }
+    advance();
+    const double exp = std::get<double>(token.value);
+
+    if (exp > std::numeric_limits<int>::max()) {
+      fail(Errc::kTooBig, token.offset);
+      return;
+    } else if (static_cast<double>(out.coefficients.size() - 1) * exp >
+               static_cast<double>(utils::max_expanded_degree)) {
+      fail(Errc::kDegreeTooBig, token.offset);
+      return;
+    }
+    base.swap(out.coefficients);
+    utils::polynomial_power(base, static_cast<unsigned>(exp),
+                            out.coefficients);
+    trim(out.coefficients);
+  }
+}
+
+void Parser::negation(Expansion& out) {
+  if (check(peek(), Token::Kind::kMinus)) {
+    advance();
+    negation(out);
+    for (double& coe : out.coefficients) {
+      coe = -coe;
+    }
+    return;
+  }
+  exponentiation(out);
+}
+
+void Parser::product(Expansion& out) {
+  Expansion           rhs{};
+  std::vector<double> result;
+
+  negation(out);
+  while (check(peek(), Token::Kind::kAsterisk) ||
+         check(peek(), Token::Kind::kSlash)) {
+    const Token oper = advance();
+
+    negation(rhs);
+    if (status || !unite(out, rhs, oper.offset)) {
+      return;
+    }
+    if (check(oper, Token::Kind::kSlash)) {
+      if (!divide(out, rhs, oper.offset)) {
+        return;
+      }
+    } else if (out.coefficients.size() + rhs.coefficients.size() - 2 >
+               utils::max_expanded_degree) {
+      fail(Errc::kDegreeTooBig, oper.offset);
+      return;
+    } else {
+      utils::polynomial_product(out.coefficients, rhs.coefficients, result);
+      out.coefficients.swap(result);
+    }
+    trim(out.coefficients);
+  }
+}
+
+void Parser::sum(Expansion& out) {
+  Expansion rhs{};
+
+  product(out);
+  while (check(peek(), Token::Kind::kPlus) ||
+         check(peek(), Token::Kind::kMinus)) {
+    const Token oper = advance();
+
+    product(rhs);
+    if (status || !unite(out, rhs, oper.offset)) {
+      return;
+    }
+    if (rhs.coefficients.size() > out.coefficients.size()) {
+      out.coefficients.resize(rhs.coefficients.size(), 0);
+    }
+    for (std::size_t i = 0; i < rhs.coefficients.size(); ++i) {
+      out.coefficients[i] += check(oper, Token::Kind::kPlus)
+                                 ? rhs.coefficients[i]
+                                 : -rhs.coefficients[i];
+    }
+    trim(out.coefficients);
+  }
+}
+
+/// @brief a factor with parentheses, multiplied out and handed to the
+/// builder as the sum of its terms. They are joined by the operator that
+/// folds the factor, so each is folded like a term written out in its
+/// place, and a negative one is a negated term like "- 2 * X^1".
+template <typename Builder>
+typename Builder::value_t Parser::expanded(Builder&          builder,
+                                           const Token::Kind oper) {
+  const std::size_t         offset = peek().offset;
+  Expansion                 group{};
+  typename Builder::value_t expr{};
+  bool                      first{true};
+
+  product(group);
+  if (status) {
+    return expr;
+  } else if (!group.var) {
+    fail(Errc::kMissingVariable, offset);
+    return expr;
+  }
+  for (std::size_t exp = 0; exp < group.coefficients.size(); ++exp) {
+    const double coe = group.coefficients[exp];
+    Term         term{std::abs(coe)};
+
+    if (!coe && (exp || group.coefficients.size() > 1)) {
+      continue;
+    }
+    term.setVar(group.var);
+    term.setExp(static_cast<int>(exp));
+    typename Builder::value_t leaf = builder.term(term);
+
+    if (coe < 0) {
+      leaf = builder.unary(Token::Kind::kMinus, leaf);
+    }
+    expr = first ? leaf
+                 : builder.binary(oper == Token::Kind::kMinus
+                                      ? Token::Kind::kMinus
+                                      : Token::Kind::kPlus,
+                                  expr, leaf);
+    first = false;
+  }
+  return expr;
+}
+
+/// @param oper the operator that folds the factor, "+" for the first of
+/// either side
+template <typename Builder>
+typename Builder::value_t Parser::factor(Builder&          builder,
+                                         const Token::Kind oper) {
+  if (!status && lexer.groupAhead()) {
+    return expanded(builder, oper);
+  }
+  typename Builder::value_t expr = power(builder);
 
   while (check(peek(), Token::Kind::kAsterisk) ||
          check(peek(), Token::Kind::kSlash)) {
     Token::Kind current = peek().kind;
     advance();
-    std::unique_ptr<node_t> rhs = power();
-    expr = std::make_unique<node_t>(BinaryExpr{current, expr, rhs});
+    typename Builder::value_t rhs = power(builder);
+    if (status) {
+      return expr;
+    }
+    expr = builder.binary(current, expr, rhs);
   }
   return expr;
 }
 
-std::unique_ptr<Parser::node_t> Parser::expression(void) {
-  std::unique_ptr<node_t> expr = factor();
+template <typename Builder>
+typename Builder::value_t Parser::expression(Builder& builder) {
+  typename Builder::value_t expr = factor(builder, Token::Kind::kPlus);
 
   while (check(peek(), Token::Kind::kPlus) ||
          check(peek(), Token::Kind::kMinus)) {
     Token::Kind current = peek().kind;
     advance();
-    std::unique_ptr<node_t> rhs = factor();
-    expr = std::make_unique<node_t>(BinaryExpr{current, expr, rhs});
+    typename Builder::value_t rhs = factor(builder, current);
+    if (status) {
+      return expr;
+    }
+    expr = builder.binary(current, expr, rhs);
   }
   return expr;
 }
 
-std::unique_ptr<Parser::node_t> Parser::equation(void) {
-  std::unique_ptr<node_t> expr = expression();
+template <typename Builder>
+typename Builder::value_t Parser::equation(Builder& builder) {
+  typename Builder::value_t expr = expression(builder);
 
   if (check(peek(), Token::Kind::kEqual)) {
     Token::Kind current = peek().kind;
     advance();
-    std::unique_ptr<node_t> rhs = expression();
+    builder.transpose();
+    typename Builder::value_t rhs = expression(builder);
     if (!check(peek(), Token::Kind::kEnd)) {
-      throw grammarError("missing end of equation token");
+      fail(Errc::kMissingEnd, peek().offset);
+    }
+    if (status) {
+      return expr;
     }
-    return std::make_unique<node_t>(BinaryExpr{current, expr, rhs});
+    return builder.binary(current, expr, rhs);
   }
   return expr;
 }
 
 /// @brief Consume tokens from lexer and build AST.
+/// @return false if the user asked to quit
 bool Parser::parse() {
-  if (check(peek(), Token::Kind::kQuit)) {
-    std::cout << "quiting computorv1\n";
+  Status error{};
+  const bool parsed = parse(error);
+
+  if (error) {
+    error.raise();
+  }
+  return parsed;
+}
+
+/// @brief same as parse, reporting a grammar error in status
+/// @return false if the user asked to quit or on error
+bool Parser::parse(Status& error) {
+  const stats::Parsing parsing{};
+
+  status = {};
+  if (check(peek(), Token::Kind::kQuit) || status) {
+    error = status;
+    stats::error(error.code);
     return false;
   }
-  tree.setRoot(equation());
-  return true;
+  TreeBuilder builder{tree};
+
+  tree.clear();
+  equation(builder);
+  if (stats::enabled()) {
+    stats::count(stats::Counter::kNodes, tree.getNodes().size());
+  }
+  error = status;
+  stats::error(error.code);
+  return !error;
+}
+
+/// @brief Consume tokens from lexer and fold them straight into the reduced
+/// form, without building a tree. Memory use is bounded by the number of
+/// distinct terms instead of the length of the equation.
+/// @return false if the user asked to quit
+bool Parser::reduce(RpnVisitor& rpn) {
+  Status error{};
+  const bool reduced = reduce(rpn, error);
+
+  if (error) {
+    error.raise();
+  }
+  return reduced;
+}
+
+/// @brief same as reduce, reporting any error in status; the terms are
+/// partially folded then
+/// @return false if the user asked to quit or on error
+bool Parser::reduce(RpnVisitor& rpn, Status& error) {
+  const stats::Parsing parsing{};
+
+  status = {};
+  if (check(peek(), Token::Kind::kQuit) || status) {
+    error = status;
+    stats::error(error.code);
+    return false;
+  }
+  Reducer builder{rpn, status};
+
+  const Term lhs = equation(builder);
+  if (!status && !builder.isEquation()) {
+    status = {Errc::kNotEquation, 0};
+  }
+  if (!status) {
+    rpn.evaluate(Token::Kind::kEqual, lhs, status);
+  }
+  if (stats::enabled()) {
+    stats::count(stats::Counter::kTerms, rpn.terms.size());
+  }
+  error = status;
+  stats::error(error.code);
+  return !error;
+}
+
+/// @brief parse the whole input as one operand of "+", "-" or "=": the
+/// terms its "*", "/" and "^" fold are appended to folds in order, and its
+/// own value, which the enclosing operator folds, is returned in value.
+/// Together they are what reduce folds for the operand at that place.
+/// @param transposed if the operand is right of "="
+/// @return false on error, in status
+bool Parser::operand(RpnVisitor& rpn, const bool transposed,
+                     std::vector<Term>& folds, Term& value, Status& error) {
+  Recorder builder{rpn, status, folds};
+
+  status = {};
+  if (transposed) {
+    builder.transpose();
+  }
+  value = factor(builder, Token::Kind::kPlus);
+  if (!check(peek(), Token::Kind::kEnd)) {
+    fail(Errc::kMissingEnd, peek().offset);
+  }
+  error = status;
+  return !error;
 }
 
 Tree& Parser::getTree() { return tree; }
 
 std::string Parser::prompt(void) {
+  std::string equation;
+
+  prompt(equation);
+  return equation;
+}
+
+/// @brief prompt for an equation into a reused string
+/// @return false at the end of the input
+bool Parser::prompt(std::string& equation) {
   constexpr std::string_view msg{"Enter a quadratic equation or 'q' to quit: "};
-  std::string                equation;
 
   std::cout << msg;
-  std::getline(std::cin, equation);
-  return equation;
+  return static_cast<bool>(std::getline(std::cin, equation));
 }
@@ -0,0 +1,161 @@
+#include "polynomial.h"
+
+#include <algorithm>
+
+#include "symbols.h"
+
+namespace {
+
+/// @brief 2^64 / phi, for Fibonacci hashing
+constexpr std::uint64_t golden{0x9E3779B97F4A7C15};
+
+constexpr unsigned log2(std::size_t n) {
+  unsigned bits{0};
+
+  while (n >>= 1) {
+    ++bits;
+  }
+  return bits;
+}
+
+}  // namespace
+
+/* Polynomial */
+
+Polynomial::Polynomial()
+    : table{},
+      shift{0},
+      order{},
+      sorted{true},
+      nonzero{0} {}
+
+/// @brief the key of var^exp
+Polynomial::monomial_t Polynomial::pack(const char var, const int exp) {
+  return monomial_t{static_cast<unsigned char>(var)} << 32 |
+         static_cast<std::uint32_t>(exp);
+}
+
+/// @brief the variable and exponent of a monomial
+Polynomial::key_t Polynomial::unpack(const monomial_t monomial) {
+  return {static_cast<char>(monomial >> 32 & 0xFF),
+          static_cast<int>(static_cast<std::uint32_t>(monomial))};
+}
+
+Term Polynomial::term(const monomial_t monomial, const double coe) {
+  const key_t key = unpack(monomial);
+  Term        term{coe};
+
+  term.setVar(key.first);
+  term.setExp(key.second);
+  return term;
+}
+
+/// @brief linear probing from the monomial's hash
+/// @return the index of its entry, or of the empty entry it would take
+std::size_t Polynomial::probe(const monomial_t monomial) const {
+  const std::size_t mask = table.size() - 1;
+  std::size_t       index = static_cast<std::size_t>((monomial * golden) >> shift);
+
+  while (table[index].monomial != monomial &&
+         table[index].monomial != empty_key) {
+    index = (index + 1) & mask;
+  }
+  return index;
+}
+
+/// @brief double the table, keeping the order of the entries
+void Polynomial::grow() {
+  std::vector<Entry> previous(
+      table.empty() ? initial_capacity : 2 * table.size(), Entry{empty_key, 0});
+
+  previous.swap(table);
+  shift = 64 - log2(table.size());
+  for (std::uint32_t &index : order) {
+    const Entry entry = previous[index];
+
+    index = static_cast<std::uint32_t>(probe(entry.monomial));
+    table[index] = entry;
+  }
+}
+
+/// @brief order the entries by variable name and exponent, once per change
+void Polynomial::sort() const {
+  if (sorted) {
+    return;
+  }
+  std::sort(order.begin(), order.end(),
+            [this](const std::uint32_t a, const std::uint32_t b) {
+              const key_t lhs = unpack(table[a].monomial);
+              const key_t rhs = unpack(table[b].monomial);
+
+              if (lhs.first == rhs.first) {
+                return lhs.second < rhs.second;
+              }
+              return symbols::name(lhs.first) < symbols::name(rhs.first);
+            });
+  sorted = true;
+}
+
+/// @brief add a term to the coefficient of its monomial
+void Polynomial::add(const Term &term) {
+  if (!term.getCoe()) {
+    return;
+  }
+  if (2 * (order.size() + 1) > table.size()) {
+    grow();
+  }
+  const monomial_t monomial = pack(term.getVar(), term.getExp());
+  const std::size_t index = probe(monomial);
+  Entry            &entry = table[index];
+
+  if (entry.monomial == empty_key) {
+    entry = {monomial, 0};
+    order.push_back(static_cast<std::uint32_t>(index));
+    sorted = false;
+  }
+  const bool was_zero = !entry.coe;
+  entry.coe += term.getCoe();
+  if (was_zero) {
+    ++nonzero;
+  } else if (!entry.coe) {
+    --nonzero;
+  }
+}
+
+/// @brief replace the coefficient of the term's monomial. x + -x is exactly
+/// 0 and 0 + y exactly y, so it ends up bit for bit the term's.
+void Polynomial::set(const Term &term) {
+  const double current = find(term.getVar(), term.getExp());
+
+  if (current) {
+    Term negated{term};
+
+    negated.setCoe(-current);
+    add(negated);
+  }
+  add(term);
+}
+
+/// @brief the coefficient of a variable raised to an exponent, 0 if absent
+double Polynomial::find(const char var, const int exp) const {
+  if (table.empty()) {
+    return 0;
+  }
+  const monomial_t monomial = pack(var, exp);
+  const Entry     &entry = table[probe(monomial)];
+  return entry.monomial == monomial ? entry.coe : 0;
+}
+
+bool Polynomial::empty() const { return !size(); }
+
+std::size_t Polynomial::size() const { return nonzero; }
+
+/// @brief forget every coefficient, keeping the table
+void Polynomial::clear() {
+  for (const std::uint32_t index : order) {
+    table[index] = {empty_key, 0};
+  }
+  order.clear();
+  nonzero = 0;
+  sorted = true;
+}
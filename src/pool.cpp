@@ -0,0 +1,106 @@
+#include "pool.h"
+
+namespace {
+
+/// @brief index of the pool worker running on this thread, if any
+thread_local const ThreadPool *current_pool{nullptr};
+thread_local unsigned          current_index{0};
+
+}  // namespace
+
+/* ThreadPool */
+
+ThreadPool::ThreadPool(const unsigned threads)
+    : queues{}, workers{}, mutex{}, available{}, pending{0}, next{0},
+      stopping{false} {
+  const unsigned count = threads ? threads : 1;
+
+  for (unsigned i = 0; i < count; ++i) {
+    queues.push_back(std::make_unique<Queue>());
+  }
+  for (unsigned i = 0; i < count; ++i) {
+    workers.emplace_back(&ThreadPool::work, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    stopping = true;
+  }
+  available.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+unsigned ThreadPool::size() const {
+  return static_cast<unsigned>(workers.size());
+}
+
+/// @brief true on a worker thread of any pool, where waiting for tasks of
+/// another pool would hold a worker that others may be waiting for
+bool ThreadPool::onWorker() { return current_pool; }
+
+/// @brief queue a task; workers push onto their own queue, other threads
+/// spread tasks round-robin
+void ThreadPool::submit(task_t task) {
+  const unsigned index =
+      current_pool == this ? current_index : next++ % size();
+  {
+    std::lock_guard<std::mutex> lock{queues[index]->mutex};
+    queues[index]->tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    ++pending;
+  }
+  available.notify_one();
+}
+
+/// @brief take the most recently queued task of a worker's own queue
+bool ThreadPool::pop(const unsigned index, task_t &task) {
+  std::lock_guard<std::mutex> lock{queues[index]->mutex};
+
+  if (queues[index]->tasks.empty()) {
+    return false;
+  }
+  task = std::move(queues[index]->tasks.back());
+  queues[index]->tasks.pop_back();
+  return true;
+}
+
+/// @brief take the oldest task of another worker's queue
+bool ThreadPool::steal(const unsigned index, task_t &task) {
+  for (unsigned i = 1; i < size(); ++i) {
+    Queue &victim = *queues[(index + i) % size()];
+
+    std::lock_guard<std::mutex> lock{victim.mutex};
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::work(const unsigned index) {
+  current_pool = this;
+  current_index = index;
+
+  for (;;) {
+    task_t task;
+
+    if (pop(index, task) || steal(index, task)) {
+      --pending;
+      task();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock{mutex};
+    available.wait(lock, [this] { return stopping || pending > 0; });
+    if (stopping && !pending) {
+      return;
+    }
+  }
+}
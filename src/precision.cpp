@@ -0,0 +1,311 @@
+#include "precision.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace precision {
+
+namespace {
+
+/* double-double */
+
+/// @brief the unevaluated sum hi + lo, |lo| <= ulp(hi) / 2: about 106 bits
+struct DoubleDouble {
+  double hi;
+  double lo;
+};
+
+/// @brief a + b exactly, for |a| >= |b| (Dekker)
+DoubleDouble fast_two_sum(const double a, const double b) {
+  const double s = a + b;
+
+  return {s, b - (s - a)};
+}
+
+/// @brief a + b exactly (Knuth)
+DoubleDouble two_sum(const double a, const double b) {
+  const double s = a + b;
+  const double v = s - a;
+
+  return {s, (a - (s - v)) + (b - v)};
+}
+
+/// @brief a * b exactly, unless its error underflows
+DoubleDouble two_product(const double a, const double b) {
+  const double p = a * b;
+
+  return {p, std::fma(a, b, -p)};
+}
+
+DoubleDouble negate(const DoubleDouble &x) { return {-x.hi, -x.lo}; }
+
+/// @brief within 3u^2 of x + y relative to the result, even where they
+/// cancel (accurate double-word addition)
+DoubleDouble add(const DoubleDouble &x, const DoubleDouble &y) {
+  const DoubleDouble s = two_sum(x.hi, y.hi);
+  const DoubleDouble t = two_sum(x.lo, y.lo);
+  const DoubleDouble r = fast_two_sum(s.hi, s.lo + t.hi);
+
+  return fast_two_sum(r.hi, r.lo + t.lo);
+}
+
+DoubleDouble multiply(const DoubleDouble &x, const DoubleDouble &y) {
+  const DoubleDouble p = two_product(x.hi, y.hi);
+
+  return fast_two_sum(p.hi, p.lo + (x.hi * y.lo + x.lo * y.hi));
+}
+
+/// @brief one long division step on the double quotient
+DoubleDouble divide(const DoubleDouble &x, const DoubleDouble &y) {
+  const double       q = x.hi / y.hi;
+  const DoubleDouble r = add(x, negate(multiply(y, {q, 0})));
+
+  return fast_two_sum(q, r.hi / y.hi);
+}
+
+/// @brief of a positive number, one Newton step on the double root
+DoubleDouble sqrt(const DoubleDouble &x) {
+  const double       s = std::sqrt(x.hi);
+  const DoubleDouble r = add(x, negate(two_product(s, s)));
+
+  return fast_two_sum(s, r.hi / (2 * s));
+}
+
+/* exact */
+
+/// @brief an exact dyadic rational, magnitude * 2^exponent, which every
+/// double and every sum and product of them is. The magnitude is in 32-bit
+/// limbs, least significant first.
+struct Dyadic {
+  std::vector<std::uint32_t> magnitude;
+  int                        exponent{0};
+  bool                       negative{false};
+};
+
+Dyadic dyadic(const double x) {
+  int          exponent{0};
+  const double fraction = std::frexp(std::abs(x), &exponent);
+  const auto   m = static_cast<std::uint64_t>(std::ldexp(fraction, 53));
+
+  return {{static_cast<std::uint32_t>(m), static_cast<std::uint32_t>(m >> 32)},
+          exponent - 53,
+          std::signbit(x)};
+}
+
+Dyadic product(const Dyadic &x, const Dyadic &y) {
+  Dyadic result{
+      std::vector<std::uint32_t>(x.magnitude.size() + y.magnitude.size(), 0),
+      x.exponent + y.exponent, x.negative != y.negative};
+
+  for (std::size_t i = 0; i < x.magnitude.size(); ++i) {
+    std::uint64_t carry{0};
+
+    for (std::size_t j = 0; j < y.magnitude.size(); ++j) {
+      const std::uint64_t t = std::uint64_t{x.magnitude[i]} * y.magnitude[j] +
+                              result.magnitude[i + j] + carry;
+
+      result.magnitude[i + j] = static_cast<std::uint32_t>(t);
+      carry = t >> 32;
+    }
+    result.magnitude[i + y.magnitude.size()] =
+        static_cast<std::uint32_t>(carry);
+  }
+  return result;
+}
+
+/// @brief the same value on limbs of 2^exponent, which must not be above
+/// the current one, and at least limbs long
+void align(Dyadic &x, const int exponent, const std::size_t limbs) {
+  const auto shift = static_cast<std::size_t>(x.exponent - exponent);
+  std::vector<std::uint32_t> shifted(
+      std::max(limbs, x.magnitude.size() + shift / 32 + 1), 0);
+
+  for (std::size_t i = 0; i < x.magnitude.size(); ++i) {
+    const std::uint64_t v = std::uint64_t{x.magnitude[i]} << (shift % 32);
+
+    shifted[i + shift / 32] |= static_cast<std::uint32_t>(v);
+    shifted[i + shift / 32 + 1] |= static_cast<std::uint32_t>(v >> 32);
+  }
+  x.magnitude.swap(shifted);
+  x.exponent = exponent;
+}
+
+bool less(const std::vector<std::uint32_t> &x,
+          const std::vector<std::uint32_t> &y) {
+  return std::lexicographical_compare(x.rbegin(), x.rend(), y.rbegin(),
+                                      y.rend());
+}
+
+Dyadic difference(Dyadic x, Dyadic y) {
+  const int         exponent = std::min(x.exponent, y.exponent);
+  const std::size_t limbs =
+      std::max(x.magnitude.size() + (x.exponent - exponent) / 32,
+               y.magnitude.size() + (y.exponent - exponent) / 32) +
+      2;
+  std::int64_t carry{0};
+
+  align(x, exponent, limbs);
+  align(y, exponent, limbs);
+  y.negative = !y.negative;
+  if (x.negative != y.negative && less(x.magnitude, y.magnitude)) {
+    std::swap(x, y);
+  }
+  for (std::size_t i = 0; i < limbs; ++i) {
+    const std::int64_t t = std::int64_t{x.magnitude[i]} + carry +
+                           (x.negative == y.negative
+                                ? std::int64_t{y.magnitude[i]}
+                                : -std::int64_t{y.magnitude[i]});
+
+    x.magnitude[i] = static_cast<std::uint32_t>(t);
+    carry = t < 0 ? -1 : t >> 32;
+  }
+  return x;
+}
+
+/* scaled */
+
+/// @brief fraction * 2^exponent. Every quantity of the solve is carried
+/// this way, with a fraction near 1, so none of them overflows or underflows
+/// whatever the spread of the coefficients.
+struct Scaled {
+  DoubleDouble fraction;
+  int          exponent;
+};
+
+Scaled split(const double x) {
+  int          exponent{0};
+  const double fraction = std::frexp(x, &exponent);
+
+  return {{fraction, 0}, exponent};
+}
+
+/// @brief x * 2^n, exact unless it underflows
+DoubleDouble ldexp(const DoubleDouble &x, const int n) {
+  return {std::ldexp(x.hi, n), std::ldexp(x.lo, n)};
+}
+
+/// @brief rounded to a double, once unless it is subnormal
+double value(const Scaled &x) {
+  return std::ldexp(x.fraction.hi, x.exponent) + 0.0;
+}
+
+/// @brief of a positive number
+Scaled sqrt(Scaled x) {
+  if (x.exponent % 2) {
+    x.fraction = ldexp(x.fraction, 1);
+    x.exponent -= 1;
+  }
+  return {sqrt(x.fraction), x.exponent / 2};
+}
+
+/// @brief rounded from the top 160 bits, more than a double-double holds
+Scaled approximate(const Dyadic &x) {
+  std::size_t  top = x.magnitude.size();
+  DoubleDouble result{0, 0};
+
+  while (top && !x.magnitude[top - 1]) {
+    --top;
+  }
+  if (!top) {
+    return {result, 0};
+  }
+  for (std::size_t i = top > 5 ? top - 5 : 0; i < top; ++i) {
+    result = add(result, {std::ldexp(static_cast<double>(x.magnitude[i]),
+                                     32 * static_cast<int>(i + 1 - top)),
+                          0});
+  }
+  return {x.negative ? negate(result) : result,
+          x.exponent + 32 * static_cast<int>(top - 1)};
+}
+
+/* solving */
+
+/// @brief the roots from a scaled discriminant, in the order and with the
+/// signs of the double tier, each rounded once. Terms brought to a common
+/// exponent only underflow where they are negligible beside the other.
+void roots(const Scaled &a, const Scaled &b, const Scaled &c,
+           const Scaled &discriminant, double &root1, double &root2,
+           double &imag, utils::Roots &kind) {
+  const bool negative = std::signbit(b.fraction.hi);
+
+  if (discriminant.fraction.hi > 0) {
+    const Scaled       root = sqrt(discriminant);
+    const int          exponent = b.fraction.hi
+                                      ? std::max(b.exponent, root.exponent)
+                                      : root.exponent;
+    const DoubleDouble sum =
+        add(ldexp(b.fraction, b.exponent - exponent),
+            ldexp(negative ? negate(root.fraction) : root.fraction,
+                  root.exponent - exponent));
+    const DoubleDouble q{-0.5 * sum.hi, -0.5 * sum.lo};
+    const double large = value({divide(q, a.fraction), exponent - a.exponent});
+    const double small = value({divide(c.fraction, q), c.exponent - exponent});
+
+    root1 = negative ? large : small;
+    root2 = negative ? small : large;
+    imag = 0;
+    kind = utils::Roots::kReal;
+    return;
+  }
+  root1 = value({{-b.fraction.hi / (2 * a.fraction.hi), 0},
+                 b.exponent - a.exponent});
+  root2 = root1;
+  imag = 0;
+  kind = utils::Roots::kDouble;
+  if (discriminant.fraction.hi < 0) {
+    const Scaled root = sqrt(Scaled{negate(discriminant.fraction),
+                                    discriminant.exponent});
+
+    imag = value({divide(root.fraction, {2 * a.fraction.hi, 0}),
+                  root.exponent - a.exponent});
+    kind = utils::Roots::kComplex;
+  }
+}
+
+}  // namespace
+
+/// @brief solve a * x^2 + b * x + c = 0 again, for a discriminant the
+/// double tier doubted, with the outputs of utils::quadratic_batch_solver.
+/// The coefficients are split into fractions and exponents: b^2 and 4ac are
+/// each an exact double-double times a power of two, and the larger fixes
+/// the exponent of the discriminant, their difference added in
+/// double-double. Where that is within 2^-100 of the magnitude of its terms,
+/// its sign is settled exactly instead, from the coefficients themselves.
+/// @return the tier that settled it; kDouble, leaving the outputs alone,
+/// when a is 0 or a coefficient is not finite
+Tier escalate(const double a, const double b, const double c, double &root1,
+              double &root2, double &imag, utils::Roots &kind) {
+  if (!a || !std::isfinite(a) || !std::isfinite(b) || !std::isfinite(c)) {
+    return Tier::kDouble;
+  }
+  const Scaled sa = split(a);
+  const Scaled sb = split(b);
+  const Scaled sc = split(c);
+  const int    pe = 2 * sb.exponent;
+  const int    qe = sa.exponent + sc.exponent + 2;
+  const int    exponent = !b ? qe : !c ? pe : std::max(pe, qe);
+  const DoubleDouble p =
+      ldexp(two_product(sb.fraction.hi, sb.fraction.hi), pe - exponent);
+  const DoubleDouble q =
+      ldexp(two_product(sa.fraction.hi, sc.fraction.hi), qe - exponent);
+  Scaled discriminant{add(p, negate(q)), exponent};
+  Tier   tier{Tier::kDoubleDouble};
+
+  if (std::abs(discriminant.fraction.hi) <=
+      0x1p-100 * (p.hi + std::abs(q.hi))) {
+    Dyadic four_a = dyadic(a);
+
+    four_a.exponent += 2;
+    tier = Tier::kExact;
+    discriminant = approximate(difference(product(dyadic(b), dyadic(b)),
+                                          product(four_a, dyadic(c))));
+  }
+  roots(sa, sb, sc, discriminant, root1, root2, imag, kind);
+  count(tier);
+  return tier;
+}
+
+}  // namespace precision
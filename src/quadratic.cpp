@@ -0,0 +1,235 @@
+#include "quadratic.h"
+
+#include <cmath>
+
+#include "numeric.h"
+#include "precision.h"
+
+#if (defined(__AVX2__) && defined(__FMA__)) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace utils {
+
+namespace {
+
+/// @brief branchless solve of a single quadratic, same results as the
+/// vector kernels for their tail elements
+/// @return 1 if the discriminant is doubtful, like the lane masks below
+unsigned solve(const double a, const double b, const double c, double &root1,
+               double &root2, double &imag, Roots &kind) {
+  bool         certain{true};
+  const double discriminant = numeric::discriminant(a, b, c, certain);
+  const double root = numeric::sqrt(std::abs(discriminant));
+  const double vertex = -b / (2 * a);
+  double plus{0};
+  double minus{0};
+
+  numeric::quadratic_roots(a, b, c, root, plus, minus);
+  root1 = (discriminant > 0 ? plus : vertex) + 0.0;
+  root2 = (discriminant > 0 ? minus : vertex) + 0.0;
+  imag = discriminant < 0 ? root / (2 * a) + 0.0 : 0.0;
+  kind = !a                ? Roots::kNone
+         : discriminant > 0 ? Roots::kReal
+         : discriminant < 0 ? Roots::kComplex
+                            : Roots::kDouble;
+  return !certain && a;
+}
+
+#if defined(__AVX512F__)
+
+constexpr std::size_t lanes{8};
+
+unsigned solve(const double *a, const double *b, const double *c,
+               double *root1, double *root2, double *imag, Roots *kind) {
+  const __m512d zero = _mm512_setzero_pd();
+  const __m512d va = _mm512_loadu_pd(a);
+  const __m512d vb = _mm512_loadu_pd(b);
+  const __m512d vc = _mm512_loadu_pd(c);
+  const __m512d two_a = _mm512_add_pd(va, va);
+  const __m512d four_a = _mm512_mul_pd(_mm512_set1_pd(4), va);
+  const __m512d b2 = _mm512_mul_pd(vb, vb);
+  const __m512d four_ac = _mm512_mul_pd(four_a, vc);
+  const __m512d naive = _mm512_sub_pd(b2, four_ac);
+  // recover the rounding errors of both products where they nearly cancel,
+  // exactly like numeric::discriminant does for the tail
+  const __m512d error = _mm512_sub_pd(_mm512_fmsub_pd(vb, vb, b2),
+                                      _mm512_fmsub_pd(four_a, vc, four_ac));
+  const __mmask8 cancels = _mm512_cmp_pd_mask(
+      _mm512_add_pd(b2, four_ac),
+      _mm512_mul_pd(_mm512_set1_pd(3), _mm512_abs_pd(naive)), _CMP_GT_OQ);
+  const __m512d  discriminant =
+      _mm512_mask_add_pd(naive, cancels, naive, error);
+  // the same certainty test as numeric::discriminant
+  const __m512d  scale = _mm512_add_pd(b2, _mm512_abs_pd(four_ac));
+  const __mmask8 in_range =
+      _mm512_cmp_pd_mask(scale, _mm512_set1_pd(0x1p996), _CMP_LT_OQ) &
+      _mm512_cmp_pd_mask(scale, _mm512_set1_pd(0x1p-900), _CMP_GT_OQ);
+  const __mmask8 trivial = _mm512_cmp_pd_mask(vb, zero, _CMP_EQ_OQ) &
+                           _mm512_cmp_pd_mask(vc, zero, _CMP_EQ_OQ);
+  const __mmask8 settled =
+      _mm512_cmp_pd_mask(_mm512_abs_pd(discriminant), _mm512_abs_pd(error),
+                         _CMP_GE_OQ);
+  const __m512d  root = _mm512_sqrt_pd(_mm512_abs_pd(discriminant));
+  const __mmask8 positive =
+      _mm512_cmp_pd_mask(discriminant, zero, _CMP_GT_OQ);
+  const __mmask8 negative =
+      _mm512_cmp_pd_mask(discriminant, zero, _CMP_LT_OQ);
+  const __mmask8 none = _mm512_cmp_pd_mask(va, zero, _CMP_EQ_OQ);
+  // sign bit of b through an integer compare, movepi64_mask needs AVX512DQ
+  const __mmask8 negative_b = _mm512_cmplt_epi64_mask(
+      _mm512_castpd_si512(vb), _mm512_setzero_si512());
+  const __m512d  signed_root = _mm512_mask_sub_pd(root, negative_b, zero, root);
+  const __m512d  q =
+      _mm512_mul_pd(_mm512_set1_pd(-0.5), _mm512_add_pd(vb, signed_root));
+  const __m512d  large = _mm512_div_pd(q, va);
+  const __m512d  small = _mm512_div_pd(vc, q);
+  const __m512d  plus = _mm512_mask_blend_pd(negative_b, small, large);
+  const __m512d  minus = _mm512_mask_blend_pd(negative_b, large, small);
+  const __m512d  vertex = _mm512_div_pd(_mm512_sub_pd(zero, vb), two_a);
+  const __m512d  first = _mm512_mask_blend_pd(positive, vertex, plus);
+  const __m512d  second = _mm512_mask_blend_pd(positive, vertex, minus);
+  const __m512d  imaginary = _mm512_div_pd(root, two_a);
+
+  _mm512_storeu_pd(root1, _mm512_add_pd(first, zero));
+  _mm512_storeu_pd(root2, _mm512_add_pd(second, zero));
+  _mm512_storeu_pd(
+      imag, _mm512_maskz_mov_pd(negative, _mm512_add_pd(imaginary, zero)));
+  for (std::size_t i = 0; i < lanes; ++i) {
+    const unsigned bit = 1u << i;
+    kind[i] = none & bit       ? Roots::kNone
+              : positive & bit ? Roots::kReal
+              : negative & bit ? Roots::kComplex
+                               : Roots::kDouble;
+  }
+  return static_cast<std::uint8_t>(
+      ~((in_range | trivial) & (~cancels | settled)) & ~none);
+}
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+constexpr std::size_t lanes{4};
+
+unsigned solve(const double *a, const double *b, const double *c,
+               double *root1, double *root2, double *imag, Roots *kind) {
+  const __m256d zero = _mm256_setzero_pd();
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  const __m256d va = _mm256_loadu_pd(a);
+  const __m256d vb = _mm256_loadu_pd(b);
+  const __m256d vc = _mm256_loadu_pd(c);
+  const __m256d two_a = _mm256_add_pd(va, va);
+  const __m256d four_a = _mm256_mul_pd(_mm256_set1_pd(4), va);
+  const __m256d b2 = _mm256_mul_pd(vb, vb);
+  const __m256d four_ac = _mm256_mul_pd(four_a, vc);
+  // recover the rounding errors of both products where they nearly cancel,
+  // exactly like numeric::discriminant does for the tail
+  const __m256d naive = _mm256_sub_pd(b2, four_ac);
+  const __m256d error = _mm256_sub_pd(_mm256_fmsub_pd(vb, vb, b2),
+                                      _mm256_fmsub_pd(four_a, vc, four_ac));
+  const __m256d cancels = _mm256_cmp_pd(
+      _mm256_add_pd(b2, four_ac),
+      _mm256_mul_pd(_mm256_set1_pd(3), _mm256_andnot_pd(sign, naive)),
+      _CMP_GT_OQ);
+  const __m256d discriminant =
+      _mm256_add_pd(naive, _mm256_and_pd(cancels, error));
+  // the same certainty test as numeric::discriminant
+  const __m256d scale = _mm256_add_pd(b2, _mm256_andnot_pd(sign, four_ac));
+  const __m256d in_range = _mm256_and_pd(
+      _mm256_cmp_pd(scale, _mm256_set1_pd(0x1p996), _CMP_LT_OQ),
+      _mm256_cmp_pd(scale, _mm256_set1_pd(0x1p-900), _CMP_GT_OQ));
+  const __m256d trivial = _mm256_and_pd(_mm256_cmp_pd(vb, zero, _CMP_EQ_OQ),
+                                        _mm256_cmp_pd(vc, zero, _CMP_EQ_OQ));
+  const __m256d settled =
+      _mm256_cmp_pd(_mm256_andnot_pd(sign, discriminant),
+                    _mm256_andnot_pd(sign, error), _CMP_GE_OQ);
+  const __m256d root = _mm256_sqrt_pd(_mm256_andnot_pd(sign, discriminant));
+  const __m256d positive = _mm256_cmp_pd(discriminant, zero, _CMP_GT_OQ);
+  const __m256d negative = _mm256_cmp_pd(discriminant, zero, _CMP_LT_OQ);
+  const __m256d none = _mm256_cmp_pd(va, zero, _CMP_EQ_OQ);
+  const __m256d signed_root = _mm256_or_pd(root, _mm256_and_pd(sign, vb));
+  const __m256d q =
+      _mm256_mul_pd(_mm256_set1_pd(-0.5), _mm256_add_pd(vb, signed_root));
+  const __m256d large = _mm256_div_pd(q, va);
+  const __m256d small = _mm256_div_pd(vc, q);
+  // blendv selects on the sign bit of b
+  const __m256d plus = _mm256_blendv_pd(small, large, vb);
+  const __m256d minus = _mm256_blendv_pd(large, small, vb);
+  const __m256d vertex = _mm256_div_pd(_mm256_sub_pd(zero, vb), two_a);
+  const __m256d first = _mm256_blendv_pd(vertex, plus, positive);
+  const __m256d second = _mm256_blendv_pd(vertex, minus, positive);
+  const __m256d imaginary = _mm256_div_pd(root, two_a);
+
+  _mm256_storeu_pd(root1, _mm256_add_pd(first, zero));
+  _mm256_storeu_pd(root2, _mm256_add_pd(second, zero));
+  _mm256_storeu_pd(imag,
+                   _mm256_and_pd(negative, _mm256_add_pd(imaginary, zero)));
+
+  const int is_positive = _mm256_movemask_pd(positive);
+  const int is_negative = _mm256_movemask_pd(negative);
+  const int is_none = _mm256_movemask_pd(none);
+  for (std::size_t i = 0; i < lanes; ++i) {
+    const int bit = 1 << i;
+    kind[i] = is_none & bit       ? Roots::kNone
+              : is_positive & bit ? Roots::kReal
+              : is_negative & bit ? Roots::kComplex
+                                  : Roots::kDouble;
+  }
+  const int is_certain =
+      (_mm256_movemask_pd(in_range) | _mm256_movemask_pd(trivial)) &
+      (~_mm256_movemask_pd(cancels) | _mm256_movemask_pd(settled));
+
+  return static_cast<unsigned>(~(is_certain | is_none)) & 0xfu;
+}
+
+#endif
+
+/// @brief solves again the elements of a block whose bit is set in
+/// doubtful, rarely any
+/// @return how many the precision tiers settled
+std::size_t escalate(unsigned doubtful, const double *a, const double *b,
+                     const double *c, double *root1, double *root2,
+                     double *imag, Roots *kind) {
+  std::size_t settled{0};
+
+  for (std::size_t i = 0; doubtful; ++i, doubtful >>= 1) {
+    if (doubtful & 1u) {
+      settled += precision::escalate(a[i], b[i], c[i], root1[i], root2[i],
+                                     imag[i], kind[i]) !=
+                 precision::Tier::kDouble;
+    }
+  }
+  return settled;
+}
+
+}  // namespace
+
+/// @brief solve many quadratics a * x^2 + b * x + c = 0 at once, without
+/// branching on the discriminant. Inputs and outputs are structures of arrays
+/// of n elements; uses AVX-512 or AVX2 with FMA when the build enables them.
+/// Elements whose discriminant is doubtful are solved again by the precision
+/// tiers.
+void quadratic_batch_solver(const double *a, const double *b, const double *c,
+                            const std::size_t n, double *root1, double *root2,
+                            double *imag, Roots *kind) {
+  std::size_t i{0};
+  std::size_t escalated{0};
+
+#if (defined(__AVX2__) && defined(__FMA__)) || defined(__AVX512F__)
+  for (; i + lanes <= n; i += lanes) {
+    if (const unsigned doubtful = solve(a + i, b + i, c + i, root1 + i,
+                                        root2 + i, imag + i, kind + i)) {
+      escalated += escalate(doubtful, a + i, b + i, c + i, root1 + i,
+                            root2 + i, imag + i, kind + i);
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    if (solve(a[i], b[i], c[i], root1[i], root2[i], imag[i], kind[i])) {
+      escalated += escalate(1, a + i, b + i, c + i, root1 + i, root2 + i,
+                            imag + i, kind + i);
+    }
+  }
+  precision::count(precision::Tier::kDouble, n - escalated);
+}
+
+}  // namespace utils
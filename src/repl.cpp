@@ -0,0 +1,61 @@
+#include "repl.h"
+
+#include <iostream>
+
+#include "symbols.h"
+
+/* Repl */
+
+Repl::Repl()
+    : par{}, interp{}, edits{}, line{}, cache{nullptr}, incremental{true} {}
+
+Repl::Repl(SolutionCache& c)
+    : par{}, interp{}, edits{}, line{}, cache{&c}, incremental{true} {}
+
+/// @brief reduce every line whole instead, as when parsing a single equation
+void Repl::setIncremental(const bool on) {
+  incremental = on;
+  edits.clear();
+}
+
+/// @brief prompt and evaluate until the user quits or the input ends
+void Repl::run() {
+  while (par.prompt(line) && step(line)) {
+  }
+}
+
+/// @brief evaluate one equation; errors are printed and do not end the loop
+/// @return false if the user asked to quit
+bool Repl::step(const std::string_view equation) {
+  try {
+    if (incremental && edits.reduce(equation)) {
+      interp.load(edits.reduced());
+      if (cache) {
+        interp.evaluateReduced(*cache);
+      } else {
+        interp.evaluateReduced();
+      }
+      return true;
+    }
+    symbols::reset();
+    par.stream(equation);
+    if (!par.parse()) {
+      std::cout << "quiting computorv1\n";
+      return false;
+    }
+    interp.reset(par.getTree());
+    if (cache) {
+      interp.evaluate(*cache);
+    } else {
+      interp.evaluate();
+    }
+  } catch (const std::exception& e) {
+    const std::string_view message{e.what()};
+
+    std::cerr << message;
+    if (message.empty() || message.back() != '\n') {
+      std::cerr << '\n';
+    }
+  }
+  return true;
+}
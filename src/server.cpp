@@ -0,0 +1,341 @@
+#include "server.h"
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+#include "batch.h"
+
+namespace server {
+
+namespace {
+
+/// @brief bytes read from a client per readiness event
+constexpr std::size_t read_size{1 << 16};
+
+/// @brief readiness events handled per epoll_wait
+constexpr int max_events{64};
+
+[[noreturn]] void fail(const std::string &what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+/// @brief a non-blocking socket listening on path, replacing a stale one
+int listen(const std::string &path) {
+  sockaddr_un address{};
+
+  if (path.size() >= sizeof(address.sun_path)) {
+    throw std::invalid_argument("socket path is too long: " + path);
+  }
+  const int fd =
+      ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd == -1) {
+    fail(path);
+  }
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+  ::unlink(path.c_str());
+  if (::bind(fd, reinterpret_cast<const sockaddr *>(&address),
+             sizeof(address)) == -1 ||
+      ::listen(fd, SOMAXCONN) == -1) {
+    const int error = errno;
+    ::close(fd);
+    throw std::system_error(error, std::generic_category(), path);
+  }
+  return fd;
+}
+
+}  // namespace
+
+/* Server */
+
+Server::Server(const std::string &p, const unsigned workers,
+               SolutionCache &c)
+    : path{p}, listener{listen(p)}, epoll{-1}, wakeup{-1}, cache{c},
+      limit{(workers ? workers : 1) * requests_per_worker}, in_flight{0},
+      busy{0}, stopping{false}, connections{}, mutex{}, ready{},
+      pool{std::make_unique<ThreadPool>(workers)} {
+  epoll = ::epoll_create1(EPOLL_CLOEXEC);
+  wakeup = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (epoll == -1 || wakeup == -1) {
+    const int error = errno;
+    ::close(listener);
+    ::unlink(path.c_str());
+    throw std::system_error(error, std::generic_category(), "epoll");
+  }
+  watch(listener, EPOLLIN, EPOLL_CTL_ADD);
+  watch(wakeup, EPOLLIN, EPOLL_CTL_ADD);
+}
+
+Server::~Server() {
+  // workers may still be waking the loop after their last request
+  pool.reset();
+  for (auto &[fd, connection] : connections) {
+    ::close(fd);
+  }
+  if (listener != -1) {
+    ::close(listener);
+    ::unlink(path.c_str());
+  }
+  ::close(wakeup);
+  ::close(epoll);
+}
+
+/// @brief serve until stop() is called, then stop accepting, finish the
+/// requests in flight and deliver their replies
+void Server::run() {
+  epoll_event events[max_events];
+
+  while (!stopping || !drained()) {
+    const int count = ::epoll_wait(epoll, events, max_events, -1);
+
+    if (count == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fail("epoll_wait");
+    }
+    for (int i = 0; i < count; ++i) {
+      const int fd = events[i].data.fd;
+
+      if (fd == listener) {
+        accept();
+      } else if (fd == wakeup) {
+        std::uint64_t value{0};
+        std::vector<connection_t> flushing;
+
+        while (::read(wakeup, &value, sizeof(value)) > 0) {
+        }
+        {
+          std::lock_guard<std::mutex> lock{mutex};
+          flushing.swap(ready);
+        }
+        for (const auto &connection : flushing) {
+          flush(connection);
+        }
+      } else if (const auto it = connections.find(fd);
+                 it != connections.end()) {
+        const connection_t connection = it->second;
+
+        if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+          read(connection);
+        }
+        if (events[i].events & EPOLLOUT) {
+          flush(connection);
+        }
+      }
+    }
+    if (stopping && listener != -1) {
+      ::epoll_ctl(epoll, EPOLL_CTL_DEL, listener, nullptr);
+      ::close(listener);
+      ::unlink(path.c_str());
+      listener = -1;
+    }
+  }
+}
+
+/// @brief ask run() to shut down gracefully; safe from any thread
+void Server::stop() {
+  const std::uint64_t one{1};
+
+  stopping = true;
+  [[maybe_unused]] const auto written = ::write(wakeup, &one, sizeof(one));
+}
+
+/// @brief requests answered with "busy" because the queue was full
+std::size_t Server::rejected() const { return busy; }
+
+void Server::accept() {
+  for (;;) {
+    const int fd = ::accept4(listener, nullptr, nullptr,
+                             SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd == -1) {
+      return;
+    }
+    auto connection = std::make_shared<Connection>();
+
+    connection->fd = fd;
+    connection->events = EPOLLIN;
+    connections.emplace(fd, connection);
+    watch(fd, EPOLLIN, EPOLL_CTL_ADD);
+  }
+}
+
+/// @brief read what the client sent and submit every complete line
+void Server::read(const connection_t &connection) {
+  char          buffer[read_size];
+  const ssize_t count = ::read(connection->fd, buffer, sizeof(buffer));
+
+  if (count == -1 && (errno == EAGAIN || errno == EINTR)) {
+    return;
+  }
+  if (count <= 0) {
+    connection->eof = true;
+    return flush(connection);
+  }
+  connection->input.append(buffer, static_cast<std::size_t>(count));
+
+  std::string_view input{connection->input};
+  while (input.find('\n') != std::string_view::npos) {
+    request(connection, batch::nextLine(input));
+  }
+  connection->input.erase(0, connection->input.size() - input.size());
+  if (connection->input.size() > max_line) {
+    connection->input.clear();
+    connection->eof = true;
+    reject(connection, "line too long");
+  }
+}
+
+/// @brief hand a line to the workers, or reject it when the server is busy
+/// or shutting down
+void Server::request(const connection_t &connection, std::string_view line) {
+  if (stopping) {
+    return reject(connection, "server shutting down");
+  }
+  if (in_flight >= limit) {
+    ++busy;
+    return reject(connection, "server busy");
+  }
+  const std::size_t number = connection->next++;
+
+  ++in_flight;
+  {
+    std::lock_guard<std::mutex> lock{connection->mutex};
+    ++connection->pending;
+  }
+  pool->submit([this, connection, number, equation = std::string{line}] {
+    std::string reply;
+    {
+      Writer out{reply};
+
+      batch::record(number, equation, out, cache);
+    }
+    complete(connection, std::move(reply));
+  });
+}
+
+/// @brief answer the next request of a connection with an error record
+void Server::reject(const connection_t &connection,
+                    const std::string_view reason) {
+  const std::size_t number = connection->next++;
+  {
+    std::lock_guard<std::mutex> lock{connection->mutex};
+
+    connection->output += std::to_string(number);
+    connection->output += ": error: ";
+    connection->output += reason;
+    connection->output += '\n';
+  }
+  flush(connection);
+}
+
+/// @brief queue a worker's reply and wake the event loop to send it
+void Server::complete(const connection_t &connection, std::string reply) {
+  const std::uint64_t one{1};
+  {
+    std::lock_guard<std::mutex> lock{connection->mutex};
+    connection->output += reply;
+    --connection->pending;
+  }
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    ready.push_back(connection);
+  }
+  // count the request done before waking the loop, which may be waiting for
+  // the last one to shut down
+  --in_flight;
+  [[maybe_unused]] const auto written = ::write(wakeup, &one, sizeof(one));
+}
+
+/// @brief send queued replies without blocking, then watch the socket for
+/// what is left to do: more requests, room to send, or nothing at all. A
+/// connection is closed once its client is done and every reply is sent.
+void Server::flush(const connection_t &connection) {
+  if (connection->fd == -1) {
+    return;
+  }
+  bool done{false};
+  {
+    std::lock_guard<std::mutex> lock{connection->mutex};
+    std::size_t                 sent{0};
+
+    while (sent < connection->output.size()) {
+      const ssize_t count =
+          ::send(connection->fd, connection->output.data() + sent,
+                 connection->output.size() - sent, MSG_NOSIGNAL);
+      if (count == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+        if (errno != EAGAIN) {
+          sent = connection->output.size();
+          connection->eof = true;
+        }
+        break;
+      }
+      sent += static_cast<std::size_t>(count);
+    }
+    connection->output.erase(0, sent);
+    done = connection->eof && connection->output.empty() &&
+           !connection->pending;
+
+    const unsigned events = (connection->eof ? 0u : EPOLLIN) |
+                            (connection->output.empty() ? 0u : EPOLLOUT);
+    if (!done && events != connection->events) {
+      watch(connection->fd, events,
+            !connection->events ? EPOLL_CTL_ADD
+            : !events           ? EPOLL_CTL_DEL
+                                : EPOLL_CTL_MOD);
+      connection->events = events;
+    }
+  }
+  if (done) {
+    close(connection);
+  }
+}
+
+/// @brief close a connection; closing its socket also removes it from epoll
+void Server::close(const connection_t &connection) {
+  ::close(connection->fd);
+  connections.erase(connection->fd);
+  connection->fd = -1;
+}
+
+void Server::watch(const int fd, const unsigned events, const int operation) {
+  epoll_event event{};
+
+  event.events = events;
+  event.data.fd = fd;
+  if (::epoll_ctl(epoll, operation, fd, &event) == -1 &&
+      operation != EPOLL_CTL_DEL) {
+    fail("epoll_ctl");
+  }
+}
+
+/// @brief true once every request has been answered and every reply sent
+bool Server::drained() {
+  if (in_flight) {
+    return false;
+  }
+  for (const auto &[fd, connection] : connections) {
+    std::lock_guard<std::mutex> lock{connection->mutex};
+
+    if (connection->pending || !connection->output.empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace server
@@ -0,0 +1,210 @@
+#include "stats.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string_view>
+
+namespace stats {
+
+namespace {
+
+constexpr std::size_t counters{static_cast<std::size_t>(Counter::kCount)};
+
+constexpr std::string_view stage_names[stages]{
+    "lex", "parse", "transpose", "reduce", "solve", "print"};
+
+std::array<Histogram, stages>                  histograms{};
+std::array<std::atomic<std::uint64_t>, counters> totals{};
+
+/// @brief "850ns", "12.3us", "4.56ms" or "1.23s"
+struct Duration {
+  std::uint64_t ns;
+};
+
+std::ostream &operator<<(std::ostream &os, const Duration duration) {
+  constexpr std::string_view units[]{"ns", "us", "ms", "s"};
+  double                     value = static_cast<double>(duration.ns);
+  std::size_t                unit{0};
+
+  while (value >= 1000 && unit + 1 < std::size(units)) {
+    value /= 1000;
+    ++unit;
+  }
+  const std::ios::fmtflags flags = os.flags();
+  const std::streamsize    precision = os.precision();
+
+  os << std::fixed << std::setprecision(unit ? 2 : 0) << value << units[unit];
+  os.flags(flags);
+  os.precision(precision);
+  return os;
+}
+
+}  // namespace
+
+/* Histogram */
+
+/// @brief values below 8ns get a bucket each, then 8 per power of two
+std::size_t Histogram::bucket(const std::uint64_t ns) {
+  if (ns < sub_buckets) {
+    return ns;
+  }
+  const unsigned exponent = 63 - __builtin_clzll(ns);
+  const unsigned sub = (ns >> (exponent - 3)) & (sub_buckets - 1);
+
+  return (exponent - 2) * sub_buckets + sub;
+}
+
+/// @brief largest value that falls into a bucket
+std::uint64_t Histogram::upper(const std::size_t index) {
+  if (index < sub_buckets) {
+    return index;
+  }
+  const unsigned      exponent = index / sub_buckets + 2;
+  const std::uint64_t sub = index % sub_buckets;
+  const std::uint64_t width = std::uint64_t{1} << (exponent - 3);
+
+  return ((sub_buckets + sub) << (exponent - 3)) + (width - 1);
+}
+
+void Histogram::add(const std::uint64_t ns) {
+  counts[bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+  samples.fetch_add(1, std::memory_order_relaxed);
+  sum.fetch_add(ns, std::memory_order_relaxed);
+
+  std::uint64_t current = longest.load(std::memory_order_relaxed);
+  while (current < ns && !longest.compare_exchange_weak(
+                             current, ns, std::memory_order_relaxed)) {
+  }
+}
+
+std::uint64_t Histogram::count() const {
+  return samples.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Histogram::total() const {
+  return sum.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Histogram::max() const {
+  return longest.load(std::memory_order_relaxed);
+}
+
+/// @brief upper bound of the bucket holding the p-th percentile (0 to 1),
+/// never above the largest sample
+std::uint64_t Histogram::percentile(const double p) const {
+  const std::uint64_t n = count();
+
+  if (!n) {
+    return 0;
+  }
+  const auto    rank = static_cast<std::uint64_t>(p * (n - 1)) + 1;
+  std::uint64_t seen{0};
+
+  for (std::size_t i = 0; i < buckets; ++i) {
+    seen += counts[i].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      return std::min(upper(i), max());
+    }
+  }
+  return max();
+}
+
+void Histogram::clear() {
+  for (auto &slot : counts) {
+    slot.store(0, std::memory_order_relaxed);
+  }
+  samples.store(0, std::memory_order_relaxed);
+  sum.store(0, std::memory_order_relaxed);
+  longest.store(0, std::memory_order_relaxed);
+}
+
+/* Recorder */
+
+void enable(const bool on) { active.store(on, std::memory_order_relaxed); }
+
+void reset() {
+  for (auto &stage : histograms) {
+    stage.clear();
+  }
+  for (auto &total : totals) {
+    total.store(0, std::memory_order_relaxed);
+  }
+}
+
+void record(const Stage stage, const clock::duration elapsed) {
+  const auto ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+
+  histograms[static_cast<std::size_t>(stage)].add(
+      static_cast<std::uint64_t>(std::max<decltype(ns)>(ns, 0)));
+}
+
+void count(const Counter which, const std::uint64_t n) {
+  totals[static_cast<std::size_t>(which)].fetch_add(
+      n, std::memory_order_relaxed);
+}
+
+void countError(const Errc code) {
+  if (code <= Errc::kInvalidRecord) {
+    count(Counter::kLexErrors);
+  } else if (code <= Errc::kQuit) {
+    count(Counter::kGrammarErrors);
+  } else if (code <= Errc::kTooBig) {
+    count(Counter::kReduceErrors);
+  } else {
+    count(Counter::kSolveErrors);
+  }
+}
+
+const Histogram &histogram(const Stage stage) {
+  return histograms[static_cast<std::size_t>(stage)];
+}
+
+std::uint64_t counter(const Counter which) {
+  return totals[static_cast<std::size_t>(which)].load(
+      std::memory_order_relaxed);
+}
+
+/// @brief one line per stage that ran, then the counters
+void report(std::ostream &os) {
+  if constexpr (!compiled) {
+    os << "statistics were compiled out (COMPUTORV1_STATS=OFF)\n";
+    return;
+  }
+  os << std::left << std::setw(10) << "stage" << std::right << std::setw(10)
+     << "count" << std::setw(10) << "total" << std::setw(10) << "p50"
+     << std::setw(10) << "p95" << std::setw(10) << "p99" << std::setw(10)
+     << "max" << '\n';
+  for (std::size_t i = 0; i < stages; ++i) {
+    const Histogram &stage = histograms[i];
+
+    if (!stage.count()) {
+      continue;
+    }
+    os << std::left << std::setw(10) << stage_names[i] << std::right
+       << std::setw(10) << stage.count();
+    for (const std::uint64_t ns :
+         {stage.total(), stage.percentile(0.50), stage.percentile(0.95),
+          stage.percentile(0.99), stage.max()}) {
+      std::ostringstream cell;
+
+      cell << Duration{ns};
+      os << std::setw(10) << cell.str();
+    }
+    os << '\n';
+  }
+  os << "equations " << counter(Counter::kEquations) << ", tokens "
+     << counter(Counter::kTokens) << ", nodes " << counter(Counter::kNodes)
+     << ", terms " << counter(Counter::kTerms) << '\n'
+     << "errors: lexing " << counter(Counter::kLexErrors) << ", grammar "
+     << counter(Counter::kGrammarErrors) << ", reduction "
+     << counter(Counter::kReduceErrors) << ", solving "
+     << counter(Counter::kSolveErrors) << '\n'
+     << "precision: double " << counter(Counter::kDoubleSolves)
+     << ", double-double " << counter(Counter::kDoubleDoubleSolves)
+     << ", exact " << counter(Counter::kExactSolves) << '\n';
+}
+
+}  // namespace stats
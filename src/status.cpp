@@ -0,0 +1,166 @@
+#include "status.h"
+
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+#include "aberth.h"
+#include "exceptions.h"
+#include "expansion.h"
+#include "writer.h"
+
+namespace {
+
+/// @brief the exception a status is raised as, the one its throwing
+/// counterpart always threw
+enum class Raise : std::uint8_t { kGrammar, kInvalidArgument, kRuntime };
+
+struct Description {
+  std::string_view text;
+  Raise            raise;
+  bool             column;  // append " at column <offset + 1>"
+};
+
+constexpr Description describe(const Errc code) {
+  switch (code) {
+    case Errc::kNone:
+      return {"no error", Raise::kRuntime, false};
+    case Errc::kEmptyInput:
+      return {"can not tokenize empty input string", Raise::kInvalidArgument,
+              false};
+    case Errc::kUnsupportedCharacter:
+      return {"character not supported: ", Raise::kGrammar, true};
+    case Errc::kNumberOverflow:
+      return {"number overflows a double", Raise::kGrammar, true};
+    case Errc::kNumberUnderflow:
+      return {"number underflows a double", Raise::kGrammar, true};
+    case Errc::kInvalidNumber:
+      return {"invalid number", Raise::kGrammar, true};
+    case Errc::kTooManyIdentifiers:
+      return {"too many distinct identifiers", Raise::kGrammar, true};
+    case Errc::kInvalidRecord:
+      return {"invalid record", Raise::kInvalidArgument, false};
+    case Errc::kMissingNumber:
+      return {"missing number in term (ex. \"42\" * X^2)", Raise::kGrammar,
+              true};
+    case Errc::kMissingAsterisk:
+      return {"missing asterisk in term (ex. 42 \"*\" X^2)", Raise::kGrammar,
+              true};
+    case Errc::kMissingVariable:
+      return {"missing variable in term (ex. 42 * \"X\"^2)", Raise::kGrammar,
+              true};
+    case Errc::kMissingCaret:
+      return {"missing caret in term (ex. 42 * X\"^\"2)", Raise::kGrammar,
+              true};
+    case Errc::kMissingExponent:
+      return {"missing exponent in term (ex. 42 * X^\"2\")", Raise::kGrammar,
+              true};
+    case Errc::kMissingEnd:
+      return {"missing end of equation token", Raise::kGrammar, true};
+    case Errc::kMissingParenthesis:
+      return {"missing closing parenthesis", Raise::kGrammar, true};
+    case Errc::kNotEquation:
+      return {"expression is not an equation", Raise::kInvalidArgument, false};
+    case Errc::kQuit:
+      return {"quit is not an equation", Raise::kGrammar, false};
+    case Errc::kUnexpectedToken:
+      return {"Unexpected token", Raise::kInvalidArgument, false};
+    case Errc::kNegateZero:
+      return {"can not negate zero", Raise::kRuntime, false};
+    case Errc::kUnlikeVariables:
+      return {"can not expand a group of different variables",
+              Raise::kRuntime, false};
+    case Errc::kIndivisible:
+      return {"can only divide a group by a non-zero monomial it is a "
+              "multiple of",
+              Raise::kRuntime, false};
+    case Errc::kDegreeTooBig:
+      return {"expanded degree too big, the upper limit is: ",
+              Raise::kInvalidArgument, false};
+    case Errc::kTooSmall:
+      return {"number too small, the lower limit is: ",
+              Raise::kInvalidArgument, false};
+    case Errc::kTooBig:
+      return {"number too big, the upper limit is: ", Raise::kInvalidArgument,
+              false};
+    case Errc::kNoTerms:
+      return {"no terms provided", Raise::kInvalidArgument, false};
+    case Errc::kSolveDegreeTooBig:
+      return {"degree too big to solve, the upper limit is: ",
+              Raise::kInvalidArgument, false};
+    case Errc::kDifferentVariables:
+      return {"can not solve equation with different variables",
+              Raise::kInvalidArgument, false};
+    case Errc::kZeroSlope:
+      return {"'slope' can not be 0", Raise::kInvalidArgument, false};
+    case Errc::kNoSolution:
+      return {"no solution available", Raise::kRuntime, false};
+    case Errc::kNoConvergence:
+      return {"roots did not converge", Raise::kRuntime, false};
+  }
+  return {"unknown error", Raise::kRuntime, false};
+}
+
+/// @brief the message, without the trailing newline some exceptions carry
+template <typename Out>
+Out& print(Out& os, const Status& status) {
+  const Description description = describe(status.code);
+
+  os << description.text;
+  if (status.code == Errc::kUnsupportedCharacter) {
+    os << status.ch;
+  } else if (status.code == Errc::kTooSmall) {
+    os << std::numeric_limits<int>::min();
+  } else if (status.code == Errc::kTooBig) {
+    os << std::numeric_limits<int>::max();
+  } else if (status.code == Errc::kDegreeTooBig) {
+    os << utils::max_expanded_degree;
+  } else if (status.code == Errc::kSolveDegreeTooBig) {
+    os << utils::max_solved_degree;
+  }
+  if (description.column) {
+    os << " at column " << status.offset + 1;
+  }
+  return os;
+}
+
+}  // namespace
+
+std::ostream& operator<<(std::ostream& os, const Status& status) {
+  return print(os, status);
+}
+
+Writer& operator<<(Writer& os, const Status& status) {
+  return print(os, status);
+}
+
+std::string Status::message() const {
+  std::ostringstream os;
+
+  os << *this;
+  return os.str();
+}
+
+/// @brief throw the exception the throwing interfaces always threw, with
+/// the same message
+void Status::raise() const {
+  const Description description = describe(code);
+  std::string       text = message();
+
+  // these were built with a trailing newline
+  if (code == Errc::kTooSmall || code == Errc::kTooBig ||
+      code == Errc::kNoSolution) {
+    text += '\n';
+  }
+  switch (description.raise) {
+    case Raise::kGrammar:
+      throw grammarError(text);
+    case Raise::kInvalidArgument:
+      throw std::invalid_argument(text);
+    case Raise::kRuntime:
+      break;
+  }
+  throw std::runtime_error(text);
+}
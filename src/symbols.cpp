@@ -0,0 +1,77 @@
+#include "symbols.h"
+
+#include <algorithm>
+#include <array>
+#include <string>
+
+namespace {
+
+constexpr unsigned char first_interned{0x80};
+
+/// @brief the names of the letters, indexed by themselves
+constexpr std::array<char, 256> letters = [] {
+  std::array<char, 256> result{};
+
+  for (int ch = 'A'; ch <= 'Z'; ++ch) {
+    result[static_cast<std::size_t>(ch)] = static_cast<char>(ch);
+    result[static_cast<std::size_t>(ch - 'A' + 'a')] =
+        static_cast<char>(ch - 'A' + 'a');
+  }
+  return result;
+}();
+
+/// @brief names stay allocated across resets, so an equation of names it
+/// has seen before allocates nothing
+struct Table {
+  std::array<std::string, symbols::capacity> names;
+  std::size_t                                count{0};
+};
+
+thread_local Table table{};
+
+symbols::symbol_t symbol(const std::size_t index) {
+  return static_cast<symbols::symbol_t>(first_interned + index);
+}
+
+}  // namespace
+
+namespace symbols {
+
+/// @brief forget the longer names of the previous equation on this thread
+void reset() { table.count = 0; }
+
+/// @brief the symbol of a variable name of letters
+/// @return 0 with Errc::kTooManyIdentifiers once the table is full
+symbol_t intern(std::string_view name, Status &status) {
+  if (name.size() == 1) {
+    return name.front();
+  }
+  const auto        end = table.names.begin() + table.count;
+  const std::size_t index =
+      static_cast<std::size_t>(std::find(table.names.begin(), end, name) -
+                               table.names.begin());
+
+  if (index < table.count) {
+    return symbol(index);
+  } else if (table.count == capacity) {
+    status = {Errc::kTooManyIdentifiers};
+    return 0;
+  }
+  table.names[table.count].assign(name);
+  return symbol(table.count++);
+}
+
+/// @brief the name of a symbol, empty if it is not a variable
+std::string_view name(const symbol_t symbol) {
+  const auto ch = static_cast<unsigned char>(symbol);
+
+  if (ch >= first_interned) {
+    const std::size_t index = ch - first_interned;
+
+    return index < table.count ? std::string_view{table.names[index]}
+                               : std::string_view{};
+  }
+  return letters[ch] ? std::string_view{&letters[ch], 1} : std::string_view{};
+}
+
+}  // namespace symbols
@@ -1,7 +1,10 @@
 #include "token.h"
 
-Token::Token() : value{std::monostate{}}, kind{} {}
+Token::Token() : value{std::monostate{}}, kind{}, offset{0} {}
 
-Token::Token(Token::Kind k, val_t t) : value{t}, kind{k} {}
+Token::Token(Token::Kind k, val_t t) : value{t}, kind{k}, offset{0} {}
 
-Token::Token(Token::Kind k) : value{std::monostate{}}, kind{k} {}
+Token::Token(Token::Kind k, val_t t, std::size_t o)
+    : value{t}, kind{k}, offset{o} {}
+
+Token::Token(Token::Kind k) : value{std::monostate{}}, kind{k}, offset{0} {}
@@ -1,18 +1,49 @@
 #include "tree.h"
 
-/* Nodes */
+/* Tree */
 
-BinaryExpr::BinaryExpr(Token::Kind k, std::unique_ptr<node_t>& l,
-                       std::unique_ptr<node_t>& r)
-    : oper{k}, left{std::move(l)}, right{std::move(r)} {}
+Tree::Tree() : nodes{}, terms{} {}
 
-UnaryExpr::UnaryExpr(Token::Kind k, std::unique_ptr<node_t>& c)
-    : oper{k}, child{std::move(c)} {}
+Tree::index_t Tree::term(const Term& term) {
+  terms.push_back(term);
+  nodes.push_back(Node{Node::Kind::kTerm, Token::Kind::kNumber,
+                       static_cast<index_t>(terms.size() - 1), 0});
+  return static_cast<index_t>(nodes.size() - 1);
+}
 
-/* Tree */
+Tree::index_t Tree::unary(Token::Kind oper, const index_t child) {
+  nodes.push_back(Node{Node::Kind::kUnary, oper, child, 0});
+  return static_cast<index_t>(nodes.size() - 1);
+}
+
+Tree::index_t Tree::binary(Token::Kind oper, const index_t left,
+                           const index_t right) {
+  nodes.push_back(Node{Node::Kind::kBinary, oper, left, right});
+  return static_cast<index_t>(nodes.size() - 1);
+}
+
+const Node& Tree::node(const index_t index) const { return nodes[index]; }
+
+const std::vector<Node>& Tree::getNodes() const { return nodes; }
+
+std::vector<Term>& Tree::getTerms() { return terms; }
+
+const std::vector<Term>& Tree::getTerms() const { return terms; }
+
+/// @brief nodes are stored in post-order, the root is the last node
+Tree::index_t Tree::getRoot() const {
+  return static_cast<index_t>(nodes.size() - 1);
+}
 
-Tree::Tree() : root{} {}
+bool Tree::empty() const { return nodes.empty(); }
 
-void Tree::setRoot(std::unique_ptr<node_t> expr) { root = std::move(expr); }
+/// @brief drop every node, keeping the storage for the next tree
+void Tree::clear() {
+  nodes.clear();
+  terms.clear();
+}
 
-std::unique_ptr<Tree::node_t>& Tree::getRoot() { return root; }
+void Tree::swap(Tree& other) {
+  nodes.swap(other.nodes);
+  terms.swap(other.terms);
+}
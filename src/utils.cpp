@@ -2,6 +2,10 @@
 
 #include <iostream>
 
+#include "numeric.h"
+#include "precision.h"
+#include "writer.h"
+
 namespace utils {
 
 void ComplexVisitor::operator()(const double& num) { std::cout << num << '\n'; }
@@ -10,11 +14,51 @@ void ComplexVisitor::operator()(const Complex& num) {
   std::cout << num << '\n';
 }
 
-std::ostream& operator<<(std::ostream& os, const Complex& num) {
+namespace {
+
+template <typename Out>
+Out& print(Out& os, const Complex& num) {
   os << num.real << (num.imag > 0 ? " + " : " - ") << absval(num.imag) << "i";
   return os;
 }
 
+/// @brief solutions from the precision tiers, false if they left it to the
+/// double one
+bool escalate(const double a, const double b, const double c,
+              std::vector<std::variant<double, Complex>>& solutions) {
+  double root1{0};
+  double root2{0};
+  double imag{0};
+  Roots  kind{Roots::kNone};
+
+  if (precision::escalate(a, b, c, root1, root2, imag, kind) ==
+      precision::Tier::kDouble) {
+    return false;
+  }
+  switch (kind) {
+    case Roots::kReal:
+      solutions.emplace_back(root1);
+      solutions.emplace_back(root2);
+      break;
+    case Roots::kComplex:
+      solutions.emplace_back(Complex{root1, -imag});
+      solutions.emplace_back(Complex{root2, imag});
+      break;
+    default:
+      solutions.emplace_back(root1);
+      break;
+  }
+  return true;
+}
+
+}  // namespace
+
+std::ostream& operator<<(std::ostream& os, const Complex& num) {
+  return print(os, num);
+}
+
+Writer& operator<<(Writer& os, const Complex& num) { return print(os, num); }
+
 double absval(const double val) { return val < 0 ? -val : val; }
 
 /// @brief exponentiate number
@@ -26,18 +70,11 @@ double exponentiation(const double b, const int n) {
 
   if (n < 0) {
     throw std::invalid_argument("can not raise to negative power");
-  } else if (!n) {
-    return 1;
-  } else if (!b) {
-    return 0;
   }
-  double result{b};
+  const double result = numeric::power(b, static_cast<unsigned>(n));
 
-  for (int i = 1; i < n; ++i) {
-    result = result * b;
-    if (result > int64_max) {
-      throw std::runtime_error("integer overflow");
-    }
+  if (result > int64_max) {
+    throw std::runtime_error("integer overflow");
   }
   return result;
 }
@@ -48,13 +85,7 @@ double squareroot(const double num) {
     throw std::invalid_argument(
         "square root of negative number is not defined");
   }
-  const double epsilon = 1e-6;
-  double       guess = num;
-
-  while (utils::absval(num - guess * guess) > epsilon) {
-    guess = (guess + num / guess) * 0.5;
-  }
-  return guess;
+  return numeric::sqrt(num);
 }
 
 /// @brief get the root of a linear equation
@@ -79,26 +110,49 @@ double linear_equation_solver(const double slope, const double intercept) {
 /// @return the roots of the equation
 std::vector<std::variant<double, Complex>> quadratic_equation_solver(
     const double a, const double b, const double c) {
+  std::vector<std::variant<double, Complex>> solutions;
+
+  quadratic_equation_solver(a, b, c, solutions);
+  return solutions;
+}
+
+/// @brief same, replacing the contents of solutions, which keeps its
+/// capacity
+void quadratic_equation_solver(
+    const double a, const double b, const double c,
+    std::vector<std::variant<double, Complex>>& solutions) {
   if (!a) {
     throw std::invalid_argument("'a' can not be 0 in the quadratic formula");
   }
+  solutions.clear();
   if (!b && !c) {
-    return std::vector<std::variant<double, Complex>>{0.0};
+    precision::count(precision::Tier::kDouble);
+    solutions.emplace_back(0.0);
+    return;
   }
-  double discriminant{utils::exponentiation(b, 2) - (4 * a * c)};
+  bool         certain{true};
+  const double discriminant{numeric::discriminant(a, b, c, certain)};
 
+  if (!certain && escalate(a, b, c, solutions)) {
+    return;
+  }
+  precision::count(precision::Tier::kDouble);
   if (!discriminant) {
-    return std::vector<std::variant<double, Complex>>{-b / (2 * a) + 0.0};
+    solutions.emplace_back(-b / (2 * a) + 0.0);
   } else if (discriminant > 0) {
-    return std::vector<std::variant<double, Complex>>{
-        (-b + utils::squareroot(discriminant)) / (2 * a) + 0.0,
-        (-b - utils::squareroot(discriminant)) / (2 * a) + 0.0};
+    double plus{0};
+    double minus{0};
+
+    numeric::quadratic_roots(a, b, c, numeric::sqrt(discriminant), plus, minus);
+    solutions.emplace_back(plus + 0.0);
+    solutions.emplace_back(minus + 0.0);
+  } else {
+    const double real{-b / (2 * a) + 0.0};
+    const double imag{utils::squareroot(-discriminant) / (2 * a) + 0.0};
+
+    solutions.emplace_back(Complex{real, -imag});
+    solutions.emplace_back(Complex{real, imag});
   }
-  return std::vector<std::variant<double, Complex>>{
-      Complex{-b / (2 * a) + 0.0,
-              -(utils::squareroot(-discriminant) / (2 * a) + 0.0)},
-      Complex{-b / (2 * a) + 0.0,
-              (utils::squareroot(-discriminant) / (2 * a) + 0.0)}};
 }
 
 }  // namespace utils
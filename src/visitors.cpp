@@ -4,116 +4,179 @@
 
 PrintVisitor::PrintVisitor() : height{0} {}
 
-void PrintVisitor::operator()(const BinaryExpr& expr) {
-  height += 1;
-  std::visit(*this, *(expr.left));
-  height -= 1;
-  std::cout << std::string(height, ' ') << static_cast<char>(expr.oper) << '\n';
-  height += 1;
-  std::visit(*this, *(expr.right));
-  height -= 1;
+void PrintVisitor::operator()(const Tree& tree, const Tree::index_t index) {
+  const Node& node = tree.node(index);
+
+  switch (node.kind) {
+    case Node::Kind::kBinary:
+      height += 1;
+      (*this)(tree, node.left);
+      height -= 1;
+      std::cout << std::string(height, ' ') << static_cast<char>(node.oper)
+                << '\n';
+      height += 1;
+      (*this)(tree, node.right);
+      height -= 1;
+      break;
+    case Node::Kind::kUnary:
+      std::cout << std::string(height, ' ') << static_cast<char>(node.oper)
+                << '\n';
+      height += 1;
+      (*this)(tree, node.left);
+      height -= 1;
+      break;
+    case Node::Kind::kTerm:
+      std::cout << std::string(height, ' ') << tree.getTerms()[node.left]
+                << '\n';
+      break;
+  }
 }
 
-void PrintVisitor::operator()(const UnaryExpr& expr) {
-  std::cout << std::string(height, ' ') << static_cast<char>(expr.oper) << '\n';
-  height += 1;
-  std::visit(*this, *(expr.child));
-  height -= 1;
+/* TransposeVisitor */
+
+/// @brief negate every term right of the root. In post-order the right
+/// subtree is the contiguous range between the left child and the root.
+void TransposeVisitor::operator()(Tree& tree) {
+  const Tree::index_t root = tree.getRoot();
+  std::vector<Term>&  terms = tree.getTerms();
+
+  for (Tree::index_t i = tree.node(root).left + 1; i < root; ++i) {
+    const Node& node = tree.node(i);
+
+    if (node.kind == Node::Kind::kTerm) {
+      (*this)(terms[node.left]);
+    }
+  }
 }
 
-void PrintVisitor::operator()(const Term& expr) {
-  std::cout << std::string(height, ' ') << expr << '\n';
+void TransposeVisitor::operator()(Term& term) {
+  term.setCoe(term > 0 ? -term.getCoe() : term.getCoe());
 }
 
-/* TransposeVisitor */
+/* RpnVisitor */
 
-void TransposeVisitor::operator()(BinaryExpr& expr) {
-  std::visit(*this, *expr.left);
-  std::visit(*this, *expr.right);
-}
+namespace {
 
-void TransposeVisitor::operator()(UnaryExpr& expr) {
-  std::visit(*this, *expr.child);
+void checkLimits(const Term& term, Status& status) {
+  if (term < std::numeric_limits<int>::min()) {
+    status = {Errc::kTooSmall};
+  } else if (term > std::numeric_limits<int>::max()) {
+    status = {Errc::kTooBig};
+  }
 }
 
-void TransposeVisitor::operator()(Term& expr) {
-  expr.setCoe(expr > 0 ? -expr.getCoe() : expr.getCoe());
+/// @brief throw the error a status-reporting overload ran into
+void raiseIf(const Status& status) {
+  if (status) {
+    status.raise();
+  }
 }
 
-/* RpnVisitor */
+}  // namespace
 
 /// @brief post-order traversal of the abstract syntax tree;
-RpnVisitor::RpnVisitor(void) : terms{} {}
+RpnVisitor::RpnVisitor(void) : terms{}, stack{} {}
 
-/// @brief try to insert term into a map, if a liketerm is known, evaluate.
+/// @brief add the term to the coefficient of its like terms
 /// @param term to remember and possibly evaluate
-void RpnVisitor::addTerm(std::pair<std::pair<char, int>, Term> term) {
-  const auto [it, success] = terms.insert(term);
-  if (!success) {
-    it->second += term.second;
-  }
-  if (!it->second) {
-    terms.erase(it);
-  }
+void RpnVisitor::addTerm(const Term& term) { terms.add(term); }
+
+/// @brief apply a unary operator to its operand
+Term RpnVisitor::unary(Token::Kind oper, const Term& term) {
+  Status status{};
+  Term   result = unary(oper, term, status);
+
+  raiseIf(status);
+  return result;
 }
 
-/// @brief evaluate the final binary expression in the AST.
-/// The program starts at the leaf and is working upwards in the AST and
-/// returns the result of every binary, unary or primary expression. This
-/// function evaluates the last binary expression in the tree.
-void RpnVisitor::evaluate(const BinaryExpr& expr, Term term) {
-  if (expr.oper == Token::Kind::kMinus) {
-    term = -term;
+Term RpnVisitor::unary(Token::Kind oper, const Term& term, Status& status) {
+  switch (oper) {
+    case Token::Kind::kMinus:
+      if (!term) {
+        status = {Errc::kNegateZero};
+        return term;
+      }
+      return -term;
+    case Token::Kind::kPlus:
+      return term;
+    default:
+      status = {Errc::kUnexpectedToken};
+      return term;
   }
-  if (term < std::numeric_limits<int>::min()) {
-    throw std::invalid_argument(
-        "number too small, the lower limit is: " +
-        std::to_string(std::numeric_limits<int>::min()) + "\n");
-  } else if (term > std::numeric_limits<int>::max()) {
-    throw std::invalid_argument(
-        "number too big, the upper limit is: " +
-        std::to_string(std::numeric_limits<int>::max()) + "\n");
+}
+
+/// @brief fold the right operand of a binary expression into the terms, the
+/// left operand is carried upwards
+void RpnVisitor::fold(Token::Kind oper, Term rhs) {
+  Status status{};
+
+  fold(oper, rhs, status);
+  raiseIf(status);
+}
+
+void RpnVisitor::fold(Token::Kind oper, Term rhs, Status& status) {
+  rhs = folded(oper, rhs, status);
+  if (!status) {
+    addTerm(rhs);
   }
-  addTerm(std::make_pair(std::make_pair(term.getVar(), term.getExp()), term));
 }
 
-Term RpnVisitor::operator()(const BinaryExpr& expr) {
-  Term lhs = std::visit(*this, *(expr.left));
-  Term rhs = std::visit(*this, *(expr.right));
-
-  if (rhs < std::numeric_limits<int>::min()) {
-    throw std::invalid_argument(
-        "number too small, the lower limit is: " +
-        std::to_string(std::numeric_limits<int>::min()) + "\n");
-  } else if (rhs > std::numeric_limits<int>::max()) {
-    throw std::invalid_argument(
-        "number too big, the upper limit is: " +
-        std::to_string(std::numeric_limits<int>::max()) + "\n");
+/// @brief the term fold adds for a right operand, without adding it
+Term RpnVisitor::folded(Token::Kind oper, Term rhs, Status& status) {
+  checkLimits(rhs, status);
+  if (!status && oper == Token::Kind::kMinus) {
+    rhs = unary(oper, rhs, status);
   }
+  return rhs;
+}
 
-  if (expr.oper == Token::Kind::kMinus) {
-    rhs = -rhs;
+/// @brief evaluate the final binary expression in the AST.
+/// The scan works upwards from the leaves and leaves the result of the root's
+/// left-most operand on the stack. This function evaluates it.
+void RpnVisitor::evaluate(Token::Kind oper, Term term) {
+  Status status{};
+
+  evaluate(oper, term, status);
+  raiseIf(status);
+}
+
+void RpnVisitor::evaluate(Token::Kind oper, Term term, Status& status) {
+  term = evaluated(oper, term, status);
+  if (!status) {
+    addTerm(term);
   }
-  addTerm(std::make_pair(std::make_pair(rhs.getVar(), rhs.getExp()), rhs));
-  return lhs;
 }
 
-Term RpnVisitor::operator()(const UnaryExpr& expr) {
-  switch (expr.oper) {
-    case Token::Kind::kMinus:
-      return -std::visit(*this, *(expr.child));
-    case Token::Kind::kPlus:
-      return std::visit(*this, *(expr.child));
-    case Token::Kind::kEnd:
-    case Token::Kind::kNumber:
-    case Token::Kind::kVariable:
-    case Token::Kind::kAsterisk:
-    case Token::Kind::kSlash:
-    case Token::Kind::kCaret:
-    case Token::Kind::kEqual:
-    case Token::Kind::kQuit:
-      throw std::invalid_argument("Unexpected token");
+/// @brief the term evaluate adds, without adding it
+Term RpnVisitor::evaluated(Token::Kind oper, Term term, Status& status) {
+  if (oper == Token::Kind::kMinus) {
+    term = unary(oper, term, status);
+  }
+  if (!status) {
+    checkLimits(term, status);
   }
+  return term;
 }
 
-Term RpnVisitor::operator()(const Term& expr) { return expr; }
+/// @brief reduce the tree with one linear scan over its post-order nodes.
+/// Every binary expression folds its right operand into the terms and keeps
+/// its left operand on the stack.
+void RpnVisitor::operator()(const Tree& tree) {
+  stack.clear();
+  for (const Node& node : tree.getNodes()) {
+    switch (node.kind) {
+      case Node::Kind::kTerm:
+        stack.push_back(tree.getTerms()[node.left]);
+        break;
+      case Node::Kind::kUnary:
+        stack.back() = unary(node.oper, stack.back());
+        break;
+      case Node::Kind::kBinary:
+        fold(node.oper, stack.back());
+        stack.pop_back();
+        break;
+    }
+  }
+  evaluate(tree.node(tree.getRoot()).oper, stack.back());
+}
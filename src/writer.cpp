@@ -0,0 +1,67 @@
+#include "writer.h"
+
+#include <atomic>
+
+namespace {
+
+std::atomic<Writer::Format> current{Writer::Format::kGeneral};
+
+}  // namespace
+
+/* Writer */
+
+Writer::Writer(std::ostream& os)
+    : stream{&os}, string{nullptr}, style{format()}, used{0} {}
+
+Writer::Writer(std::string& s)
+    : stream{nullptr}, string{&s}, style{format()}, used{0} {}
+
+Writer::~Writer() { flush(); }
+
+/// @brief the format of writers constructed from now on
+void Writer::setFormat(const Format f) {
+  current.store(f, std::memory_order_relaxed);
+}
+
+Writer::Format Writer::format() {
+  return current.load(std::memory_order_relaxed);
+}
+
+Writer& Writer::operator<<(const double value) {
+  // "-1.2345678901234567e-308" is the longest shortest representation
+  constexpr std::size_t longest{32};
+
+  if (capacity - used < longest) {
+    flush();
+  }
+  char* const             first = buffer + used;
+  std::to_chars_result    result{};
+  constexpr int           stream_precision{6};
+
+  if (style == Format::kShortest) {
+    result = std::to_chars(first, buffer + capacity, value);
+  } else {
+    result = std::to_chars(first, buffer + capacity, value,
+                           std::chars_format::general, stream_precision);
+  }
+  used = result.ptr - buffer;
+  return *this;
+}
+
+/// @brief hand the buffered output to the stream or string
+void Writer::flush() {
+  if (!used) {
+    return;
+  }
+  write({buffer, used});
+  used = 0;
+}
+
+Writer& Writer::write(const std::string_view s) {
+  if (stream) {
+    stream->write(s.data(), static_cast<std::streamsize>(s.size()));
+  } else {
+    string->append(s);
+  }
+  return *this;
+}
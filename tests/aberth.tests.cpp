@@ -0,0 +1,177 @@
+#include "aberth.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <future>
+#include <random>
+#include <vector>
+
+#include "pool.h"
+
+namespace {
+
+/// @brief roots as complex numbers, sorted by real, then imaginary part
+std::vector<std::complex<double>> sorted(const utils::PolynomialRoots& roots) {
+  std::vector<std::complex<double>> result{};
+
+  for (std::size_t i = 0; i < roots.real.size(); ++i) {
+    result.emplace_back(roots.real[i], roots.imag[i]);
+  }
+  std::sort(result.begin(), result.end(), [](const auto& l, const auto& r) {
+    return l.real() != r.real() ? l.real() < r.real() : l.imag() < r.imag();
+  });
+  return result;
+}
+
+}  // namespace
+
+TEST(polynomial_roots, cubic) {
+  // (x - 1)(x - 2)(x - 3)
+  const auto roots = utils::polynomial_roots({-6, 11, -6, 1});
+  const auto z = sorted(roots);
+
+  ASSERT_TRUE(roots.converged);
+  ASSERT_EQ(z.size(), 3);
+  for (std::size_t i = 0; i < z.size(); ++i) {
+    EXPECT_NEAR(z[i].real(), i + 1.0, 1e-12);
+    EXPECT_NEAR(z[i].imag(), 0, 1e-12);
+  }
+}
+
+TEST(polynomial_roots, rootsOfUnity) {
+  constexpr std::size_t degree{64};
+  std::vector<double>   coefficients(degree + 1);
+
+  coefficients.front() = -1;
+  coefficients.back() = 1;
+  const auto roots = utils::polynomial_roots(coefficients);
+
+  ASSERT_TRUE(roots.converged);
+  ASSERT_EQ(roots.real.size(), degree);
+  for (const auto& z : sorted(roots)) {
+    EXPECT_NEAR(std::abs(z), 1, 1e-13);
+    EXPECT_NEAR(std::abs(std::pow(z, static_cast<int>(degree)) - 1.0), 0,
+                1e-12);
+  }
+}
+
+TEST(polynomial_roots, zeroRoots) {
+  // x^2 (x + 2)
+  const auto z = sorted(utils::polynomial_roots({0, 0, 2, 1}));
+
+  ASSERT_EQ(z.size(), 3);
+  EXPECT_NEAR(z[0].real(), -2, 1e-14);
+  EXPECT_EQ(z[1], 0.0);
+  EXPECT_EQ(z[2], 0.0);
+}
+
+TEST(polynomial_roots, doubleRoot) {
+  // (x - 1)^2 (x + 2)
+  const auto roots = utils::polynomial_roots({2, -3, 0, 1});
+  const auto z = sorted(roots);
+
+  ASSERT_TRUE(roots.converged);
+  EXPECT_NEAR(z[0].real(), -2, 1e-12);
+  EXPECT_NEAR(std::abs(z[1] - 1.0), 0, 1e-7);
+  EXPECT_NEAR(std::abs(z[2] - 1.0), 0, 1e-7);
+}
+
+TEST(polynomial_roots, highDegree) {
+  constexpr std::size_t            degree{1000};
+  std::mt19937_64                  random{42};
+  std::uniform_real_distribution<> coefficient{-1, 1};
+  std::vector<double>              coefficients(degree + 1);
+
+  for (auto& c : coefficients) {
+    c = coefficient(random);
+  }
+  const auto roots = utils::polynomial_roots(coefficients);
+
+  ASSERT_TRUE(roots.converged);
+  ASSERT_EQ(roots.real.size(), degree);
+  // the roots of a real polynomial come in conjugate pairs
+  const auto z = sorted(roots);
+  double     imag{0};
+
+  for (const auto& root : z) {
+    imag += root.imag();
+  }
+  EXPECT_NEAR(imag, 0, 1e-9);
+}
+
+TEST(polynomial_roots, threadsDoNotChangeResult) {
+  constexpr std::size_t            degree{300};
+  std::mt19937_64                  random{7};
+  std::uniform_real_distribution<> coefficient{-1, 1};
+  std::vector<double>              coefficients(degree + 1);
+
+  for (auto& c : coefficients) {
+    c = coefficient(random);
+  }
+  utils::Convergence serial{};
+  utils::Convergence threaded{};
+
+  serial.parallel_degree = degree + 1;
+  threaded.parallel_degree = 1;
+  threaded.threads = 4;
+  const auto one = utils::polynomial_roots(coefficients, serial);
+  const auto four = utils::polynomial_roots(coefficients, threaded);
+
+  EXPECT_EQ(one.iterations, four.iterations);
+  EXPECT_EQ(one.real, four.real);
+  EXPECT_EQ(one.imag, four.imag);
+}
+
+/// @brief on a pool worker the iteration stays serial: a single worker
+/// waiting for tasks of its own pool would never run them
+TEST(polynomial_roots, serialOnPoolWorkers) {
+  constexpr std::size_t            degree{64};
+  std::mt19937_64                  random{3};
+  std::uniform_real_distribution<> coefficient{-1, 1};
+  std::vector<double>              coefficients(degree + 1);
+  utils::Convergence               threaded{};
+
+  for (auto& c : coefficients) {
+    c = coefficient(random);
+  }
+  threaded.parallel_degree = 1;
+  threaded.threads = 4;
+  const auto expected = utils::polynomial_roots(coefficients, threaded);
+
+  for (int round = 0; round < 2; ++round) {
+    std::promise<utils::PolynomialRoots> promise;
+    auto                                 result = promise.get_future();
+    {
+      ThreadPool worker{1};
+
+      worker.submit([&] {
+        EXPECT_TRUE(ThreadPool::onWorker());
+        promise.set_value(utils::polynomial_roots(coefficients, threaded));
+      });
+    }
+    const auto roots = result.get();
+
+    EXPECT_EQ(roots.real, expected.real);
+    EXPECT_EQ(roots.imag, expected.imag);
+  }
+  EXPECT_FALSE(ThreadPool::onWorker());
+}
+
+TEST(polynomial_roots, iterationLimit) {
+  utils::Convergence convergence{};
+
+  convergence.max_iterations = 1;
+  const auto roots = utils::polynomial_roots({-6, 11, -6, 1}, convergence);
+
+  EXPECT_FALSE(roots.converged);
+  EXPECT_EQ(roots.iterations, 1);
+}
+
+TEST(polynomial_roots, constant) {
+  EXPECT_THROW(utils::polynomial_roots({3, 0, 0}), std::invalid_argument);
+  EXPECT_THROW(utils::polynomial_roots({}), std::invalid_argument);
+  EXPECT_THROW(utils::polynomial_roots({1, NAN}), std::invalid_argument);
+}
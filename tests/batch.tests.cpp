@@ -0,0 +1,133 @@
+#include "batch.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+/* nextLine */
+
+TEST(nextLine, splitsWithoutTerminators) {
+  std::string_view input{"1 * X^1 = 0\r\n2 * X^1 = 4\nlast"};
+
+  EXPECT_EQ(batch::nextLine(input), "1 * X^1 = 0");
+  EXPECT_EQ(batch::nextLine(input), "2 * X^1 = 4");
+  EXPECT_EQ(batch::nextLine(input), "last");
+  EXPECT_TRUE(input.empty());
+}
+
+TEST(nextLine, keepsEmptyLines) {
+  std::string_view input{"\n\n"};
+
+  EXPECT_EQ(batch::nextLine(input), "");
+  EXPECT_EQ(batch::nextLine(input), "");
+  EXPECT_TRUE(input.empty());
+}
+
+/* run */
+
+TEST(batch, oneRecordPerLine) {
+  std::ostringstream os;
+
+  batch::run(
+      "1 * X^2 - 3 * X^1 - 4 * X^0 = 0\n"
+      "42 * X^0 = 42 * X^0\n"
+      "5 * X^0 + 4 * X^1 = 4 * X^0\n",
+      os);
+  EXPECT_EQ(os.str(),
+            "1: 4, -1\n"
+            "2: all real numbers\n"
+            "3: 0.25\n");
+}
+
+TEST(batch, malformedLineDoesNotStopRun) {
+  std::ostringstream os;
+
+  batch::run("1 * X\n\n2 * X^1 = 4 * X^0", os);
+  EXPECT_EQ(os.str(),
+            "1: error: missing caret in term (ex. 42 * X\"^\"2) at column 6\n"
+            "2: error: missing number in term (ex. \"42\" * X^2) at column 1\n"
+            "3: -2\n");
+}
+
+TEST(batch, complexSolutions) {
+  std::ostringstream os;
+
+  batch::run("3 * X^2 + 3 * X^1 + 4 * X^0 = 0", os);
+  EXPECT_EQ(os.str(), "1: -0.5 - 1.04083i, -0.5 + 1.04083i\n");
+}
+
+/* MappedFile */
+
+/// @brief every line interns its names afresh, so a run can use many more
+/// of them than one equation can
+TEST(batch, namesPerLine) {
+  std::string        input;
+  std::ostringstream expected;
+
+  for (int i = 0; i < 300; ++i) {
+    const std::string name{"v" + std::string(1, 'a' + i % 26) +
+                           std::string(1, 'a' + i / 26)};
+
+    input += "2 * " + name + "^1 = 4 * " + name + "^0\n";
+    expected << i + 1 << ": -2\n";
+  }
+  std::ostringstream os;
+
+  batch::run(input, os);
+  EXPECT_EQ(os.str(), expected.str());
+}
+
+TEST(mappedFile, mapsWholeFile) {
+  const std::string path{testing::TempDir() + "computorv1_batch.txt"};
+  {
+    std::ofstream file{path};
+    file << "1 * X^1 = 2 * X^0\n";
+  }
+  batch::MappedFile  file{path};
+  std::ostringstream os;
+
+  batch::run(file.view(), os);
+  EXPECT_EQ(os.str(), "1: -2\n");
+  std::remove(path.c_str());
+}
+
+TEST(mappedFile, missingFile) {
+  EXPECT_THROW(batch::MappedFile{"/nonexistent/computorv1"}, std::system_error);
+}
+
+/* parallel run */
+
+TEST(batch, parallelKeepsInputOrder) {
+  std::string input;
+  for (int i = 0; i < 5000; ++i) {
+    input += std::to_string(i % 7 + 1) + " * X^1 = " + std::to_string(i) +
+             (i % 11 ? " * X^0\n" : "\n");
+  }
+  std::ostringstream sequential;
+  std::ostringstream parallel;
+
+  batch::run(input, sequential);
+  batch::run(input, parallel, 4);
+  EXPECT_EQ(sequential.str(), parallel.str());
+}
+
+/* cache */
+
+TEST(batch, sharedCacheCountsRepeats) {
+  std::ostringstream os;
+  SolutionCache      cache{batch::cache_entries};
+
+  batch::run(
+      "2 * X^2 = 8 * X^0\n"
+      "2 * Y^2 - 8 * Y^0 = 0\n"
+      "1 * X^1 = 2 * X^0\n",
+      os, 2, cache);
+  EXPECT_EQ(os.str(),
+            "1: 2, -2\n"
+            "2: 2, -2\n"
+            "3: -2\n");
+  EXPECT_EQ(cache.hits(), 1);
+  EXPECT_EQ(cache.misses(), 2);
+}
@@ -0,0 +1,172 @@
+#include "binary.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <sstream>
+
+#include "batch.h"
+
+namespace {
+
+/// @brief the equation "c0 * X^0 + c1 * X^1 + ... = 0"
+std::string equation(const std::vector<double>& coefficients) {
+  std::ostringstream os;
+
+  for (std::size_t exp = 0; exp < coefficients.size(); ++exp) {
+    const double coefficient = coefficients[exp];
+
+    if (exp) {
+      os << (coefficient < 0 ? " - " : " + ");
+    } else if (coefficient < 0) {
+      os << "-";
+    }
+    os << std::abs(coefficient) << " * X^" << exp;
+  }
+  os << " = 0";
+  return os.str();
+}
+
+std::string solve(const std::string& input) {
+  std::ostringstream os;
+
+  binary::run(input, os);
+  return os.str();
+}
+
+}  // namespace
+
+/// @brief every record solves to what the same equation does as text
+/// without a cache, across several chunks and every degree the interpreter solves
+TEST(binary, matchesTextBatch) {
+  constexpr unsigned    max_degree{4};
+  constexpr std::size_t count{2 * binary::chunk_records + 37};
+
+  std::mt19937                       rng{42};
+  std::uniform_int_distribution<int> degree{0, max_degree};
+  std::uniform_int_distribution<int> value{-9, 9};
+  std::string                        input;
+  std::ostringstream                 expected;
+
+  binary::appendHeader(input, max_degree, count);
+  for (std::size_t i = 0; i < count; ++i) {
+    std::vector<double> coefficients(degree(rng) + 1);
+
+    for (double& coefficient : coefficients) {
+      coefficient = value(rng);
+    }
+    coefficients.front() = coefficients.front() ? coefficients.front() : 1;
+    binary::appendRecord(input, max_degree, 'X', coefficients);
+    batch::record(i + 1, equation(coefficients), expected);
+  }
+  const std::string actual = solve(input);
+  const std::string text = expected.str();
+  std::string_view  actual_lines{actual};
+  std::string_view  expected_lines{text};
+
+  while (!expected_lines.empty()) {
+    ASSERT_EQ(batch::nextLine(actual_lines), batch::nextLine(expected_lines));
+  }
+  EXPECT_TRUE(actual_lines.empty());
+}
+
+/// @brief --batch solves through a SolutionCache and --binary does not: the
+/// same equations, repeated so the cache serves some of them, print the same
+/// records either way
+TEST(binary, matchesCachedTextBatch) {
+  constexpr unsigned    max_degree{3};
+  constexpr std::size_t distinct{200};
+  constexpr std::size_t count{binary::chunk_records + 300};
+
+  std::mt19937                               rng{7};
+  std::uniform_int_distribution<int>         degree{1, max_degree};
+  std::uniform_int_distribution<int>         value{-99, 99};
+  std::uniform_int_distribution<std::size_t> pick{0, distinct - 1};
+  std::vector<std::vector<double>>           equations(distinct);
+  std::string                                input;
+  std::string                                lines;
+
+  for (auto& coefficients : equations) {
+    coefficients.resize(degree(rng) + 1);
+    for (double& coefficient : coefficients) {
+      coefficient = value(rng);
+    }
+    coefficients.back() = coefficients.back() ? coefficients.back() : 1;
+  }
+  binary::appendHeader(input, max_degree, count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto& coefficients = equations[pick(rng)];
+
+    binary::appendRecord(input, max_degree, 'X', coefficients);
+    lines += equation(coefficients) + "\n";
+  }
+  SolutionCache      cache{batch::cache_entries};
+  std::ostringstream text;
+
+  batch::run(lines, text, cache);
+  EXPECT_GT(cache.hits(), 0);
+  EXPECT_EQ(solve(input), text.str());
+}
+
+TEST(binary, records) {
+  std::string input;
+
+  binary::appendHeader(input, 2, 4);
+  binary::appendRecord(input, 2, 'X', {-4, -3, 1});
+  binary::appendRecord(input, 2, 'Y', {4, 3, 3});
+  binary::appendRecord(input, 2, 'X', {0, 0, 0});
+  binary::appendRecord(input, 2, 'X', {5});
+  EXPECT_EQ(solve(input),
+            "1: 4, -1\n"
+            "2: -0.5 - 1.04083i, -0.5 + 1.04083i\n"
+            "3: all real numbers\n"
+            "4: error: 'slope' can not be 0\n");
+}
+
+/// @brief doubtful quadratics go through the same higher precision tiers
+TEST(binary, extremeSpread) {
+  std::string input;
+
+  binary::appendHeader(input, 2, 2);
+  binary::appendRecord(input, 2, 'X', {1e-300, 1e200, 1});
+  binary::appendRecord(input, 2, 'X', {1, 1e200, 1});
+  EXPECT_EQ(solve(input),
+            "1: 0, -1e+200\n"
+            "2: -1e-200, -1e+200\n");
+}
+
+TEST(binary, invalidRecords) {
+  std::string input;
+
+  binary::appendHeader(input, 2, 3);
+  binary::appendRecord(input, 2, 'x', {1, 1});
+  binary::appendRecord(input, 2, 'X', {1, NAN});
+  binary::appendRecord(input, 2, 'X', {1, 2, 3});
+  input[binary::header_size + 2 * binary::recordSize(2)] = 3;
+  EXPECT_EQ(solve(input),
+            "1: error: invalid record\n"
+            "2: error: invalid record\n"
+            "3: error: invalid record\n");
+}
+
+TEST(binary, header) {
+  std::string input;
+
+  binary::appendHeader(input, 3, 1);
+  EXPECT_EQ(input.size(), binary::header_size);
+  EXPECT_THROW(binary::header(input), std::invalid_argument);
+  binary::appendRecord(input, 3, 'X', {1, 2});
+  EXPECT_EQ(input.size(), binary::header_size + binary::recordSize(3));
+
+  const binary::Header header = binary::header(input);
+  EXPECT_EQ(header.version, binary::version);
+  EXPECT_EQ(header.max_degree, 3);
+  EXPECT_EQ(header.count, 1u);
+
+  EXPECT_THROW(binary::header("CV1A" + input.substr(4)),
+               std::invalid_argument);
+  EXPECT_THROW(binary::header(input.substr(0, 8)), std::invalid_argument);
+  input[4] = 2;
+  EXPECT_THROW(binary::header(input), std::invalid_argument);
+}
@@ -0,0 +1,225 @@
+#include "cache.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "interpreter.h"
+#include "stats.h"
+
+namespace {
+
+/// @brief solve an equation through the cache
+Interpreter::solutions_t solve(const std::string& equation,
+                               SolutionCache&     cache) {
+  Parser      par{equation};
+  Interpreter interp{};
+
+  interp.reduce(par);
+  interp.solve(cache);
+  return interp.getSolutions();
+}
+
+/// @brief same value and sign bits, which == does not tell for -0.0
+bool identical(const double x, const double y) {
+  return !std::memcmp(&x, &y, sizeof(x));
+}
+
+bool identical(const std::variant<double, utils::Complex>& x,
+               const std::variant<double, utils::Complex>& y) {
+  if (x.index() != y.index()) {
+    return false;
+  }
+  if (const auto* real = std::get_if<double>(&x)) {
+    return identical(*real, std::get<double>(y));
+  }
+  const auto& a = std::get<utils::Complex>(x);
+  const auto& b = std::get<utils::Complex>(y);
+
+  return identical(a.real, b.real) && identical(a.imag, b.imag);
+}
+
+}  // namespace
+
+/// @brief forms that differ by a power of two factor share a key, other
+/// multiples and sides of a linear slope do not
+TEST(solutionCache, keyedByScaledCoefficients) {
+  EXPECT_EQ(SolutionCache::key(1, 0, -4), SolutionCache::key(1, 0, -4));
+  EXPECT_EQ(SolutionCache::key(2, 0, -8), SolutionCache::key(1, 0, -4));
+  EXPECT_EQ(SolutionCache::key(-0.25, 3, 0.5), SolutionCache::key(-1, 12, 2));
+  EXPECT_EQ(SolutionCache::key(1, -0.0, -4), SolutionCache::key(1, 0, -4));
+  EXPECT_EQ(SolutionCache::key(0, 3, -0.0), SolutionCache::key(0, 6, 0));
+  EXPECT_EQ(SolutionCache::key(0, 0.75, 1), SolutionCache::key(0, 0.375, 0.5));
+  EXPECT_FALSE(SolutionCache::key(3, 0, -12) == SolutionCache::key(1, 0, -4));
+  EXPECT_FALSE(SolutionCache::key(0, 2, 4) == SolutionCache::key(0, 1, 2));
+  EXPECT_FALSE(SolutionCache::key(1, 0, -4) == SolutionCache::key(0, 1, -4));
+}
+
+TEST(solutionCache, countsHitsAndMisses) {
+  SolutionCache cache{8};
+
+  const auto first = solve("2 * X^2 = 8 * X^0", cache);
+  const auto second = solve("1 * X^2 - 4 * X^0 = 0", cache);
+  const auto third = solve("1 * Y^2 = 9 * Y^0", cache);
+
+  EXPECT_EQ(cache.misses(), 2);
+  EXPECT_EQ(cache.hits(), 1);
+  EXPECT_EQ(cache.size(), 2);
+  for (const auto& solutions : {first, second}) {
+    EXPECT_EQ(std::get<double>(solutions.at(0)), 2);
+    EXPECT_EQ(std::get<double>(solutions.at(1)), -2);
+  }
+  EXPECT_EQ(std::get<double>(third.at(0)), 3);
+}
+
+/// @brief random forms, some with a cancelling discriminant, scaled by
+/// powers of two: through one shared key they solve to the bits of solving
+/// each without a cache
+TEST(solutionCache, scaledKeysBitIdentical) {
+  std::mt19937                           rng{11};
+  std::uniform_real_distribution<double> value{-1000, 1000};
+  std::uniform_int_distribution<int>     exponent{-150, 150};
+
+  for (int i = 0; i < 10000; ++i) {
+    const double a = value(rng);
+    const double b = value(rng);
+    const double c = i % 2 ? value(rng) : b * b / (4 * a);
+    const int    shift = exponent(rng);
+    const double scaled[]{std::ldexp(a, shift), std::ldexp(b, shift),
+                          std::ldexp(c, shift)};
+    const auto   key = SolutionCache::key(scaled[0], scaled[1], scaled[2]);
+
+    ASSERT_EQ(key, SolutionCache::key(a, b, c));
+    const auto cached = SolutionCache::solve(key);
+    const auto uncached =
+        utils::quadratic_equation_solver(scaled[0], scaled[1], scaled[2]);
+
+    ASSERT_EQ(cached.size(), uncached.size());
+    for (std::size_t j = 0; j < cached.size(); ++j) {
+      ASSERT_TRUE(identical(cached[j], uncached[j])) << a << ' ' << b << ' '
+                                                      << c << ' ' << shift;
+    }
+    const double slope = std::ldexp(b, shift);
+    const double linear = utils::linear_equation_solver(slope, scaled[2]);
+    const auto   solved = SolutionCache::solve(SolutionCache::key(0, slope,
+                                                                  scaled[2]));
+
+    ASSERT_TRUE(identical(std::get<double>(solved.at(0)), linear))
+        << b << ' ' << c << ' ' << shift;
+  }
+}
+
+TEST(solutionCache, matchesUncachedSolve) {
+  SolutionCache cache{8};
+
+  EXPECT_EQ(std::get<double>(solve("5 * X^0 + 4 * X^1 = 4 * X^0", cache)[0]),
+            0.25);
+  const auto complex = solve("3 * X^2 + 3 * X^1 + 4 * X^0 = 0", cache);
+  EXPECT_EQ(std::get<utils::Complex>(complex[0]).real, -0.5);
+  EXPECT_DOUBLE_EQ(std::get<utils::Complex>(complex[1]).imag,
+                   std::sqrt(39.0) / 6);
+}
+
+/// @brief the first solve of each equation misses, the second hits; both
+/// must be what solving without a cache gives, to the bit
+TEST(solutionCache, bitIdenticalToUncachedSolve) {
+  SolutionCache cache{64};
+
+  for (const std::string equation :
+       {"7 * X^2 + 3 * X^1 + 0.3214285714285714 * X^0 = 0",
+        "3 * X^2 + 2 * X^1 + 0.3333333333333333 * X^0 = 0",
+        "3 * X^2 + 0.1 * X^1 - 0.7 * X^0 = 0",
+        "0.000001 * X^2 + 100000000 * X^1 + 1 * X^0 = 0",
+        "0.1 * X^1 + 0.3 * X^0 = 0"}) {
+    Parser      par{equation};
+    Interpreter uncached{};
+
+    uncached.reduce(par);
+    uncached.solve();
+    for (int pass = 0; pass < 2; ++pass) {
+      const auto cached = solve(equation, cache);
+
+      ASSERT_EQ(cached.size(), uncached.getSolutions().size()) << equation;
+      for (std::size_t i = 0; i < cached.size(); ++i) {
+        EXPECT_TRUE(identical(cached[i], uncached.getSolutions()[i]))
+            << equation;
+      }
+    }
+  }
+  EXPECT_EQ(cache.hits(), 5);
+}
+
+/// @brief a miss on a doubtful quadratic escalates on its own coefficients,
+/// and a hit returns the escalated roots without solving again
+TEST(solutionCache, escalatesOnMiss) {
+  if (!stats::compiled) {
+    GTEST_SKIP() << "built with COMPUTORV1_STATS=OFF";
+  }
+  SolutionCache cache{8};
+  const double  b{0x9000000000001p0};
+  const auto    key = SolutionCache::key((b - 1) / 2, b, (b + 1) / 2);
+
+  stats::reset();
+  stats::enable();
+  cache.insert(key, SolutionCache::solve(key));
+  const auto solutions = cache.find(key);
+  stats::enable(false);
+
+  ASSERT_TRUE(solutions);
+  ASSERT_EQ(solutions->size(), 2u);
+  EXPECT_EQ(std::get<double>(solutions->at(0)), -1);
+  EXPECT_EQ(std::get<double>(solutions->at(1)), -0x1.0000000000004p+0);
+  EXPECT_EQ(stats::counter(stats::Counter::kExactSolves), 1u);
+  EXPECT_EQ(stats::counter(stats::Counter::kDoubleSolves), 0u);
+}
+
+TEST(solutionCache, evictsLeastRecentlyUsed) {
+  SolutionCache cache{2};
+  const auto    a = SolutionCache::key(1, 1, 0);
+  const auto    b = SolutionCache::key(1, 2, 0);
+  const auto    c = SolutionCache::key(1, 3, 0);
+
+  cache.insert(a, SolutionCache::solve(a));
+  cache.insert(b, SolutionCache::solve(b));
+  EXPECT_TRUE(cache.find(a));
+  cache.insert(c, SolutionCache::solve(c));
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_TRUE(cache.find(a));
+  EXPECT_FALSE(cache.find(b));
+  EXPECT_TRUE(cache.find(c));
+}
+
+TEST(solutionCache, zeroCapacityNeverStores) {
+  SolutionCache cache{0};
+
+  solve("1 * X^1 = 2 * X^0", cache);
+  solve("1 * X^1 = 2 * X^0", cache);
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.misses(), 2);
+}
+
+TEST(solutionCache, sharedBetweenThreads) {
+  SolutionCache            cache{16};
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&cache] {
+      for (int i = 0; i < 1000; ++i) {
+        const auto key = SolutionCache::key(1, i % 32, 0);
+
+        if (!cache.find(key)) {
+          cache.insert(key, SolutionCache::solve(key));
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(cache.hits() + cache.misses(), 4000);
+  EXPECT_EQ(cache.size(), 16);
+}
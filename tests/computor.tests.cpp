@@ -0,0 +1,165 @@
+#include "computor.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <string_view>
+
+#include "interpreter.h"
+
+namespace {
+
+constexpr std::string_view equations[]{
+    "1 * X^2 - 3 * X^1 - 4 * X^0 = 0",
+    "5 * X^0 + 4 * X^1 - 9.3 * X^2 = 1 * X^0",
+    "5 * X^0 + 4 * X^1 = 4 * X^0",
+    "42 * X^1 - 10 * X^0 = 0",
+    "84 * X^1 - 20 * X^0 = 42 * X^1 - 10 * X^0",
+    "- - 3 * X^2 + 2 * X^1 * 4 * X^0 = - 1 * X^1",
+    "3 * X^2 + 3 * X^1 + 4 * X^0 = 0",
+    "1 * X^2 + 2 * X^1 + 1 * X^0 = 0",
+    "4 * X^2 = 0",
+    "0.1 * Y^2 + 0.7 * Y^1 - 1200.50 * Y^0 = 0.3 * Y^0",
+    "1 * X^2 - 1 * X^0 = 1 * X^2 - 1 * X^0",
+    "1 * X^2 + 1 * X^1 = 0",
+    "1 * X^3 - 1 * X^3 + 1 * X^1 = 2 * X^0",
+};
+
+constexpr std::size_t count{std::size(equations)};
+
+constexpr std::array<computor::Solution, count> solveAll() {
+  std::array<computor::Solution, count> solutions{};
+
+  for (std::size_t i = 0; i < count; ++i) {
+    solutions[i] = computor::solve(equations[i]);
+  }
+  return solutions;
+}
+
+constexpr std::array<computor::Solution, count> solved = solveAll();
+
+/// @brief positive numbers across many magnitudes, from a fixed seed
+constexpr double sample(const std::size_t i) {
+  std::uint64_t state = 0x9e3779b97f4a7c15u * (i + 1);
+
+  state ^= state >> 29;
+  state *= 0xbf58476d1ce4e5b9u;
+  state ^= state >> 32;
+  double       x = 1 + static_cast<double>(state >> 11) / (1ull << 53);
+  const int    exponent = static_cast<int>(state % 121) - 60;
+  const double two = exponent < 0 ? 0.5 : 2;
+
+  for (int e = 0; e < (exponent < 0 ? -exponent : exponent); ++e) {
+    x *= two;
+  }
+  return x;
+}
+
+constexpr std::size_t samples{2000};
+
+constexpr std::array<double, samples> roots() {
+  std::array<double, samples> result{};
+
+  for (std::size_t i = 0; i < samples; ++i) {
+    result[i] = numeric::constant::sqrt(sample(i));
+  }
+  return result;
+}
+
+constexpr std::array<double, samples> sqrts = roots();
+
+}  // namespace
+
+TEST(computor, compileTime) {
+  constexpr auto solution = computor::solve("1 * X^2 - 3 * X^1 - 4 * X^0 = 0");
+
+  static_assert(solution.count == 2);
+  static_assert(std::get<double>(solution.solutions[0]) == 4);
+  static_assert(std::get<double>(solution.solutions[1]) == -1);
+  static_assert(computor::solve("1 * X^0 = 1 * X^0").all_reals);
+  static_assert(computor::solve("2 * X^1 = 1 * X^0").degree == 1);
+  static_assert(Term{2, 'X', 1} + Term{3, 'X', 1} == Term{5, 'X', 1});
+}
+
+namespace {
+
+/// @brief whether constant evaluation trusts the discriminant of a quadratic
+constexpr bool certain(const double a, const double b, const double c) {
+  bool result{false};
+
+  numeric::constant::discriminant(a, b, c, result);
+  return result;
+}
+
+}  // namespace
+
+/// @brief a discriminant that cancels out exactly is trusted and solved;
+/// one the runtime solves again in double-double is refused
+TEST(computor, nearCancellingDiscriminant) {
+  constexpr auto square = computor::solve("1 * X^2 - 2 * X^1 + 1 * X^0 = 0");
+
+  static_assert(certain(1, -2, 1));
+  static_assert(square.count == 1);
+  static_assert(std::get<double>(square.solutions[0]) == 1);
+  static_assert(!certain(4.364384, 558.926974, 17894.814151596));
+  EXPECT_THROW(computor::solve("4.364384 * X^2 + 558.926974 * X^1 + "
+                               "17894.814151596 * X^0 = 0"),
+               std::invalid_argument);
+}
+
+TEST(computor, matchesRuntime) {
+  for (std::size_t i = 0; i < count; ++i) {
+    Parser      par{equations[i]};
+    Interpreter interp{};
+
+    interp.reduce(par);
+    interp.solve();
+    const auto expected = interp.getSolutions();
+    const auto actual = solved[i];
+
+    ASSERT_EQ(actual.count, expected.size()) << equations[i];
+    EXPECT_EQ(actual.all_reals, interp.allReals()) << equations[i];
+    for (std::size_t j = 0; j < actual.count; ++j) {
+      ASSERT_EQ(actual.solutions[j].index(), expected[j].index());
+      if (const auto *real = std::get_if<double>(&expected[j])) {
+        EXPECT_EQ(std::get<double>(actual.solutions[j]), *real)
+            << equations[i];
+      } else {
+        const auto complex = std::get<utils::Complex>(expected[j]);
+
+        EXPECT_EQ(std::get<utils::Complex>(actual.solutions[j]).real,
+                  complex.real)
+            << equations[i];
+        EXPECT_EQ(std::get<utils::Complex>(actual.solutions[j]).imag,
+                  complex.imag)
+            << equations[i];
+      }
+    }
+  }
+}
+
+TEST(computor, sqrtCorrectlyRounded) {
+  for (std::size_t i = 0; i < samples; ++i) {
+    EXPECT_EQ(sqrts[i], std::sqrt(sample(i))) << sample(i);
+  }
+  static_assert(numeric::constant::sqrt(4) == 2);
+  static_assert(numeric::constant::sqrt(0.25) == 0.5);
+  static_assert(numeric::constant::sqrt(0) == 0);
+}
+
+TEST(computor, runtimeErrors) {
+  EXPECT_THROW(computor::solve("1 * X"), grammarError);
+  EXPECT_THROW(computor::solve("1 * X^2 + 1 * Y^1 = 0"), std::invalid_argument);
+  EXPECT_THROW(computor::solve("1 * X^1 + 2 * X^0"), std::invalid_argument);
+  EXPECT_THROW(computor::solve("1 * X^3 = 0"), std::invalid_argument);
+  EXPECT_THROW(computor::solve("1 * X^2 + 3000000000 * X^1 = 0"),
+               std::invalid_argument);
+  EXPECT_THROW(computor::solve("0.12345678901234567 * X^1 = 0"),
+               grammarError);
+  try {
+    computor::solve("1 * X^2 = 1 & X^0");
+  } catch (const grammarError &e) {
+    EXPECT_STREQ(e.what(), "character not supported: & at column 13");
+  }
+}
@@ -0,0 +1,243 @@
+#include "diskcache.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <cstdint>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// @brief a cache file path removed again at the end of the test
+struct TempPath {
+  std::string path{testing::TempDir() + "computorv1_cache.bin"};
+
+  TempPath() { std::remove(path.c_str()); }
+  ~TempPath() { std::remove(path.c_str()); }
+};
+
+/// @brief the file offset of the only used slot of a cache file: slots of
+/// 64 bytes follow a 64 byte header, a sequence number then the words
+std::streamoff usedSlot(const std::string &path) {
+  std::ifstream bytes{path, std::ios::binary};
+  std::uint64_t slot[8];
+
+  for (std::streamoff offset = 64; bytes.seekg(offset); offset += 64) {
+    if (!bytes.read(reinterpret_cast<char *>(slot), sizeof(slot))) {
+      break;
+    }
+    if (slot[1]) {
+      return offset;
+    }
+  }
+  return -1;
+}
+
+/// @brief overwrite the 64-bit word at offset of a file
+void poke(const std::string &path, const std::streamoff offset,
+          const std::uint64_t value) {
+  std::fstream bytes{path, std::ios::in | std::ios::out | std::ios::binary};
+
+  bytes.seekp(offset);
+  bytes.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+}  // namespace
+
+TEST(diskCache, sharedBetweenInstances) {
+  TempPath   file{};
+  const auto real = SolutionCache::key(1, -1, -2);
+  const auto complex = SolutionCache::key(3, 3, 4);
+  {
+    DiskCache writer{file.path, 64};
+
+    writer.insert(real, SolutionCache::solve(real));
+    writer.insert(complex, SolutionCache::solve(complex));
+  }
+  DiskCache reader{file.path, 64};
+
+  const auto roots = reader.find(real);
+  ASSERT_TRUE(roots);
+  EXPECT_EQ(std::get<double>(roots->at(0)), 2);
+  EXPECT_EQ(std::get<double>(roots->at(1)), -1);
+
+  const auto conjugates = reader.find(complex);
+  ASSERT_TRUE(conjugates);
+  EXPECT_EQ(std::get<utils::Complex>(conjugates->at(0)).real, -0.5);
+  EXPECT_EQ(std::get<utils::Complex>(conjugates->at(1)).imag,
+            std::get<utils::Complex>(SolutionCache::solve(complex).at(1)).imag);
+  EXPECT_FALSE(reader.find(SolutionCache::key(1, 5, 6)));
+}
+
+TEST(diskCache, keepsSizeOfExistingFile) {
+  TempPath file{};
+
+  DiskCache first{file.path, 100};
+  EXPECT_EQ(first.slots(), 128);
+  DiskCache second{file.path, 4096};
+  EXPECT_EQ(second.slots(), 128);
+}
+
+TEST(diskCache, otherFormatIsReplaced) {
+  TempPath   file{};
+  const auto key = SolutionCache::key(1, 0, -4);
+  {
+    DiskCache cache{file.path, 64};
+
+    cache.insert(key, SolutionCache::solve(key));
+  }
+  {
+    std::fstream bytes{file.path,
+                       std::ios::in | std::ios::out | std::ios::binary};
+    const std::uint32_t future{DiskCache::version + 1};
+
+    bytes.seekp(8);
+    bytes.write(reinterpret_cast<const char*>(&future), sizeof(future));
+  }
+  DiskCache cache{file.path, 64};
+
+  EXPECT_FALSE(cache.find(key));
+}
+
+TEST(diskCache, otherSolverIsReplaced) {
+  TempPath   file{};
+  const auto key = SolutionCache::key(1, 0, -4);
+  {
+    DiskCache cache{file.path, 64};
+
+    cache.insert(key, SolutionCache::solve(key));
+  }
+  poke(file.path, 24, utils::solver_revision + 1);
+  DiskCache cache{file.path, 64};
+
+  EXPECT_FALSE(cache.find(key));
+}
+
+/// @brief a slot count whose size wraps around to the length of the file is
+/// not trusted
+TEST(diskCache, wrappingSlotCountIsReplaced) {
+  TempPath file{};
+  {
+    DiskCache cache{file.path, 64};
+  }
+  std::filesystem::resize_file(file.path, 64);
+  poke(file.path, 16, std::uint64_t{1} << 58);
+
+  DiskCache  cache{file.path, 64};
+  const auto key = SolutionCache::key(1, 0, -4);
+
+  EXPECT_EQ(cache.slots(), 64);
+  cache.insert(key, SolutionCache::solve(key));
+  EXPECT_TRUE(cache.find(key));
+}
+
+/// @brief a writer that died mid-write leaves its slot's sequence odd, which
+/// does not hide an entry whose words are whole
+TEST(diskCache, oddSequenceIsRead) {
+  TempPath   file{};
+  const auto key = SolutionCache::key(1, 0, -4);
+  {
+    DiskCache cache{file.path, 64};
+
+    cache.insert(key, SolutionCache::solve(key));
+  }
+  const std::streamoff slot = usedSlot(file.path);
+  ASSERT_NE(slot, -1);
+  poke(file.path, slot, 7);
+
+  DiskCache  cache{file.path, 64};
+  const auto found = cache.find(key);
+  ASSERT_TRUE(found);
+  EXPECT_EQ(std::get<double>(found->at(0)), 2);
+}
+
+/// @brief words torn by a writer that died are skipped by their checksum,
+/// and the next insert of the key claims the slot again
+TEST(diskCache, tornSlotIsSkipped) {
+  TempPath   file{};
+  const auto key = SolutionCache::key(1, 0, -4);
+  {
+    DiskCache cache{file.path, 64};
+
+    cache.insert(key, SolutionCache::solve(key));
+  }
+  const std::streamoff slot = usedSlot(file.path);
+  ASSERT_NE(slot, -1);
+  poke(file.path, slot, 7);
+  poke(file.path, slot + 8 * 5, 0);
+
+  DiskCache cache{file.path, 64};
+  EXPECT_FALSE(cache.find(key));
+
+  cache.insert(key, SolutionCache::solve(key));
+  const auto found = cache.find(key);
+  ASSERT_TRUE(found);
+  EXPECT_EQ(std::get<double>(found->at(0)), 2);
+  EXPECT_EQ(std::get<double>(found->at(1)), -2);
+
+  std::ifstream bytes{file.path, std::ios::binary};
+  std::uint64_t sequence{};
+  bytes.seekg(slot);
+  bytes.read(reinterpret_cast<char *>(&sequence), sizeof(sequence));
+  EXPECT_EQ(sequence % 2, 0);
+}
+
+TEST(diskCache, boundedBySlots) {
+  TempPath  file{};
+  DiskCache cache{file.path, 16};
+
+  for (int i = 0; i < 1000; ++i) {
+    const auto key = SolutionCache::key(1, i, 0);
+
+    cache.insert(key, SolutionCache::solve(key));
+  }
+  const auto last = SolutionCache::key(1, 999, 0);
+  EXPECT_TRUE(cache.find(last));
+  EXPECT_EQ(cache.slots(), 16);
+}
+
+TEST(diskCache, backsSolutionCache) {
+  TempPath   file{};
+  DiskCache  disk{file.path, 64};
+  const auto key = SolutionCache::key(2, 0, -8);
+  {
+    SolutionCache cache{8, disk};
+
+    cache.insert(key, SolutionCache::solve(key));
+  }
+  SolutionCache cache{8, disk};
+
+  EXPECT_TRUE(cache.find(key));
+  EXPECT_TRUE(cache.find(key));
+  EXPECT_EQ(cache.hits(), 2);
+  EXPECT_EQ(cache.diskHits(), 1);
+  EXPECT_EQ(cache.misses(), 0);
+}
+
+TEST(diskCache, concurrentReadersAndWriters) {
+  TempPath                 file{};
+  DiskCache                cache{file.path, 64};
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&cache] {
+      for (int i = 0; i < 2000; ++i) {
+        const auto key = SolutionCache::key(1, i % 100, -1);
+
+        if (const auto found = cache.find(key)) {
+          const auto expected = SolutionCache::solve(key);
+          EXPECT_EQ(std::get<double>(found->at(0)),
+                    std::get<double>(expected.at(0)));
+        } else {
+          cache.insert(key, SolutionCache::solve(key));
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
@@ -0,0 +1,103 @@
+#include "expansion.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<double> polynomial(std::mt19937 &rng, const std::size_t size,
+                               const int magnitude) {
+  std::uniform_int_distribution<int> coefficient{-magnitude, magnitude};
+  std::vector<double>                result(size);
+
+  for (double &c : result) {
+    c = coefficient(rng);
+  }
+  return result;
+}
+
+std::vector<double> product(const std::vector<double> &a,
+                            const std::vector<double> &b,
+                            const utils::Product       algorithm) {
+  std::vector<double> result;
+
+  utils::polynomial_product(a, b, result, algorithm);
+  return result;
+}
+
+}  // namespace
+
+/// @brief on integers every method is exact, so they agree bit for bit,
+/// balanced or not
+TEST(expansion, productsAgree) {
+  std::mt19937 rng{42};
+
+  for (const auto &[na, nb] :
+       {std::pair{1, 1}, {3, 40}, {33, 33}, {100, 37}, {700, 1300},
+        {1024, 1024}, {2000, 600}}) {
+    const auto a = polynomial(rng, na, 1000);
+    const auto b = polynomial(rng, nb, 1000);
+    const auto expected = product(a, b, utils::Product::kSchoolbook);
+
+    ASSERT_EQ(expected.size(), a.size() + b.size() - 1);
+    EXPECT_EQ(product(a, b, utils::Product::kKaratsuba), expected) << na;
+    EXPECT_EQ(product(a, b, utils::Product::kNtt), expected) << na;
+    EXPECT_EQ(product(a, b, utils::Product::kAuto), expected) << na;
+  }
+}
+
+TEST(expansion, karatsubaOnReals) {
+  std::mt19937                           rng{7};
+  std::uniform_real_distribution<double> coefficient{-1, 1};
+  std::vector<double>                    a(300);
+  std::vector<double>                    b(200);
+
+  for (double &c : a) {
+    c = coefficient(rng);
+  }
+  for (double &c : b) {
+    c = coefficient(rng);
+  }
+  EXPECT_FALSE(utils::ntt_exact(a, b));
+  const auto expected = product(a, b, utils::Product::kSchoolbook);
+  const auto actual = product(a, b, utils::Product::kNtt);
+
+  ASSERT_EQ(actual.size(), expected.size());
+  for (std::size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_NEAR(actual[i], expected[i], 1e-12) << i;
+  }
+}
+
+TEST(expansion, nttExactness) {
+  EXPECT_TRUE(utils::ntt_exact({1, -2, 3}, {4, 5}));
+  EXPECT_FALSE(utils::ntt_exact({0.5}, {1}));
+  EXPECT_FALSE(utils::ntt_exact(std::vector<double>(4, 1e8),
+                                std::vector<double>(4, 1e8)));
+}
+
+TEST(expansion, binomialPower) {
+  std::vector<double> power;
+
+  utils::polynomial_power({1, 1}, 10, power);
+  EXPECT_EQ(power, (std::vector<double>{1, 10, 45, 120, 210, 252, 210, 120,
+                                        45, 10, 1}));
+  utils::polynomial_power({2, -1}, 0, power);
+  EXPECT_EQ(power, std::vector<double>{1});
+}
+
+/// @brief squaring gives what repeated multiplication does
+TEST(expansion, powerBySquaring) {
+  std::mt19937              rng{3};
+  const std::vector<double> base = polynomial(rng, 9, 3);
+  std::vector<double>       expected{1};
+  std::vector<double>       power;
+
+  for (int i = 0; i < 13; ++i) {
+    expected = product(expected, base, utils::Product::kSchoolbook);
+  }
+  utils::polynomial_power(base, 13, power);
+  EXPECT_EQ(power, expected);
+}
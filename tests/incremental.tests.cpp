@@ -0,0 +1,142 @@
+#include "incremental.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cctype>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<Term> terms(const Polynomial &coefficients) {
+  std::vector<Term> result;
+
+  coefficients.forEach([&result](const Term &term) { result.push_back(term); });
+  return result;
+}
+
+/// @brief the reduced form of a full reduction
+/// @return false if it fails
+bool reduceWhole(std::string_view equation, std::vector<Term> &result) {
+  Parser     par{equation};
+  RpnVisitor rpn{};
+  Status     status{};
+
+  if (!par.reduce(rpn, status)) {
+    return false;
+  }
+  result = terms(rpn.terms);
+  return true;
+}
+
+/// @return if the equation is valid
+bool expectSameAsWhole(Incremental &edits, std::string_view equation) {
+  std::vector<Term> expected;
+  const bool        valid = reduceWhole(equation, expected);
+
+  EXPECT_EQ(edits.reduce(equation), valid) << equation;
+  if (!valid) {
+    return false;
+  }
+  const std::vector<Term> actual = terms(edits.reduced());
+
+  EXPECT_EQ(actual.size(), expected.size()) << equation;
+  for (std::size_t i = 0; i < std::min(actual.size(), expected.size()); ++i) {
+    EXPECT_EQ(actual[i].getCoe(), expected[i].getCoe()) << equation;
+    EXPECT_EQ(actual[i].getVar(), expected[i].getVar()) << equation;
+    EXPECT_EQ(actual[i].getExp(), expected[i].getExp()) << equation;
+  }
+  return true;
+}
+
+/// @brief a long equation of terms with inexact coefficients, so that the
+/// order of the additions shows in the result
+std::string equation(std::mt19937 &rng, const std::size_t count) {
+  std::uniform_int_distribution<int> digits{0, 99999};
+  std::uniform_int_distribution<int> exponent{0, 3};
+  std::uniform_int_distribution<int> coin{0, 1};
+  std::string                        result;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i == count / 2) {
+      result += " = ";
+    } else if (i) {
+      result += coin(rng) ? " + " : " - ";
+    }
+    result += std::to_string(digits(rng)) + "." +
+              std::to_string(digits(rng)) + " * X^" +
+              std::to_string(exponent(rng));
+    if (!coin(rng) && !coin(rng)) {
+      result += " * 0.1 * X^" + std::to_string(exponent(rng));
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+/// @brief editing a coefficient, an exponent or the variable of one term
+/// reduces only that operand, and gives the full reduction bit for bit
+TEST(incremental, editsMatchWholeReduction) {
+  std::mt19937                       rng{42};
+  std::string                        line = equation(rng, 500);
+  Incremental                        edits{};
+  std::uniform_int_distribution<int> digit{1, 9};
+  bool                               valid = expectSameAsWhole(edits, line);
+
+  ASSERT_TRUE(valid);
+  EXPECT_FALSE(edits.reused());
+  for (int i = 0; i < 2000; ++i) {
+    std::uniform_int_distribution<std::size_t> position{0, line.size() - 1};
+    const std::size_t                          at = position(rng);
+
+    if (std::isdigit(static_cast<unsigned char>(line[at]))) {
+      line[at] = static_cast<char>('0' + digit(rng));
+      if (i % 3 == 0) {
+        line.insert(at, 1, static_cast<char>('0' + digit(rng)));
+      }
+    } else if (line[at] == 'X' && i % 5 == 0) {
+      line[at] = 'Y';
+      expectSameAsWhole(edits, line);
+      line[at] = 'X';
+    } else {
+      continue;
+    }
+    const bool was_valid = valid;
+
+    valid = expectSameAsWhole(edits, line);
+    EXPECT_EQ(edits.reused(), was_valid && valid) << line;
+  }
+}
+
+TEST(incremental, operatorEditsReduceWhole) {
+  Incremental edits{};
+
+  expectSameAsWhole(edits, "1 * X^2 + 2 * X^1 = 3 * X^0");
+  expectSameAsWhole(edits, "1 * X^2 - 2 * X^1 = 3 * X^0");
+  EXPECT_FALSE(edits.reused());
+  expectSameAsWhole(edits, "1 * X^2 - 2 * X^1 = 3 * X^0 + 4 * X^1");
+  EXPECT_FALSE(edits.reused());
+  expectSameAsWhole(edits, "1 * X^2 - 2 * X^1 = 3 * X^0 + 4.5 * X^1");
+  EXPECT_TRUE(edits.reused());
+  expectSameAsWhole(edits, "1 * X^2 - 2 * X^1 = 3 * X^0 + 4.5 * X^1");
+  EXPECT_TRUE(edits.reused());
+}
+
+/// @brief edits that make the equation invalid are refused, so the caller
+/// reports them, and the next valid one is reduced whole
+TEST(incremental, invalidEquations) {
+  Incremental edits{};
+
+  for (const char *line :
+       {"1 * X^2 = 0", "1 * X^2 = 0 * X^0", "1 * X 2 = 0", "1 * X^2 = 0",
+        "0 = 1 * X^2", "1 * X^2 $ = 0", "1 * X^2 = 2147483648 * X^0",
+        "1 * X^2 = 1 * X^0", "1 * X^2 + 0 * X^1 = 1 * X^0",
+        "1 * X^2 - 0 * X^1 = 1 * X^0", "1 * X^2", "q", "1 * X^2 = 1 * X^0",
+        "1 * X^2 = 1 * X^0 = 1", "1 * X^2 * -2 * X^1 = 1 * X^0",
+        "1 * X^2 * 3 -2 * X^1 = 1 * X^0", ""}) {
+    expectSameAsWhole(edits, line);
+  }
+}
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <sstream>
 
 TEST(interpreter, goodMonomial) {
   Parser par{"4 * X^2 = 0"};
@@ -52,8 +53,6 @@ TEST(interpreter, codamExampleOne) {
 }
 
 TEST(interpreter, codamExampleTwo) {
-  constexpr double expectedSolutionOne{0.25};
-
   Parser par{"5 * X^0 + 4 * X^1 = 4 * X^0"};
   par.parse();
   Interpreter interp{par.getTree()};
@@ -67,8 +66,67 @@ TEST(interpreter, codamExampleThree) {
   Parser par{"8 * X^0 - 6 * X^1 + 0 * X^2 - 5.6 * X^3 = 3 * X^0"};
   par.parse();
   Interpreter interp{par.getTree()};
+  interp.evaluate();
+
+  // one real root and a complex conjugate pair
+  const auto solutions = interp.getSolutions();
+  ASSERT_EQ(solutions.size(), 3);
+  const double real = std::get<double>(solutions.at(2));
+  const auto   pair = std::get<utils::Complex>(solutions.at(0));
+
+  EXPECT_NEAR(-5.6 * real * real * real - 6 * real + 5, 0, 1e-12);
+  EXPECT_NEAR(pair.real, std::get<utils::Complex>(solutions.at(1)).real,
+              1e-12);
+  EXPECT_NEAR(pair.imag, -std::get<utils::Complex>(solutions.at(1)).imag,
+              1e-12);
+}
+
+/// @brief the iteration finds double roots to about sqrt(eps), a little
+/// off the real axis; their error bounds make them real again
+TEST(interpreter, repeatedRoots) {
+  Parser par{"1 * X^4 - 2 * X^2 + 1 * X^0 = 0"};
+  par.parse();
+  Interpreter interp{par.getTree()};
+  interp.evaluate();
+
+  const auto solutions = interp.getSolutions();
+  ASSERT_EQ(solutions.size(), 4);
+  for (std::size_t i = 0; i < solutions.size(); ++i) {
+    ASSERT_TRUE(std::holds_alternative<double>(solutions[i])) << i;
+    EXPECT_NEAR(std::get<double>(solutions[i]), i < 2 ? -1 : 1, 1e-7);
+  }
+
+  // (X^2 + 1)^2 has double roots off the axis, which stay complex
+  Parser squared{"1 * X^4 + 2 * X^2 + 1 * X^0 = 0"};
+  squared.parse();
+  Interpreter complex{squared.getTree()};
+  complex.evaluate();
+
+  ASSERT_EQ(complex.getSolutions().size(), 4);
+  for (const auto& solution : complex.getSolutions()) {
+    ASSERT_TRUE(std::holds_alternative<utils::Complex>(solution));
+    EXPECT_NEAR(std::abs(std::get<utils::Complex>(solution).imag), 1, 1e-7);
+  }
+}
+
+/// @brief pairs are exactly conjugate and print their negative part first
+TEST(interpreter, conjugatePairs) {
+  Parser par{"1 * X^5 - 1 * X^0 = 0"};
+  par.parse();
+  Interpreter interp{par.getTree()};
+  interp.evaluate();
+
+  const auto solutions = interp.getSolutions();
+  ASSERT_EQ(solutions.size(), 5);
+  for (const std::size_t i : {0, 2}) {
+    const auto minus = std::get<utils::Complex>(solutions[i]);
+    const auto plus = std::get<utils::Complex>(solutions[i + 1]);
 
-  EXPECT_THROW(interp.evaluate(), std::invalid_argument);
+    EXPECT_EQ(minus.real, plus.real);
+    EXPECT_EQ(minus.imag, -plus.imag);
+    EXPECT_LT(minus.imag, 0);
+  }
+  EXPECT_NEAR(std::get<double>(solutions[4]), 1, 1e-15);
 }
 
 TEST(interpreter, linearEquation) {
@@ -119,6 +177,29 @@ TEST(interpreter, identityEquation) {
   EXPECT_EQ(interp.getSolutions().size(), 0);
 }
 
+/// @brief a degree past max_solved_degree is refused before its dense
+/// coefficients are allocated, with or without a cache
+TEST(interpreter, degreeTooBigToSolve) {
+  const std::string equations[]{
+      "1 * X^50000 = 1 * X^0",
+      "1 * X^2000000000 = 1 * X^0",
+  };
+  SolutionCache cache{8};
+
+  for (const auto& equation : equations) {
+    Parser      par{equation};
+    Interpreter interp{};
+    Status      status{};
+
+    interp.reduce(par);
+    interp.solve(status);
+    EXPECT_EQ(status.code, Errc::kSolveDegreeTooBig) << equation;
+    interp.solve(cache, status);
+    EXPECT_EQ(status.code, Errc::kSolveDegreeTooBig) << equation;
+    EXPECT_TRUE(interp.getSolutions().empty());
+  }
+}
+
 TEST(interpreter, missingEquation) {
   Parser par{"1 * X^2"};
   par.parse();
@@ -126,3 +207,72 @@ TEST(interpreter, missingEquation) {
 
   EXPECT_THROW(par.parse(), grammarError);
 }
+
+/* streaming reduction */
+
+namespace {
+
+/// @brief solutions of the tree path, or the error it threw
+std::string reduceTree(const std::string& equation) {
+  try {
+    Parser par{equation};
+    par.parse();
+    Interpreter interp{par.getTree()};
+    interp.reduce();
+    interp.solve();
+    std::ostringstream os;
+    for (const auto& solution : interp.getSolutions()) {
+      std::visit([&os](const auto& s) { os << s << ' '; }, solution);
+    }
+    return os.str();
+  } catch (const std::exception& e) {
+    return e.what();
+  }
+}
+
+/// @brief solutions of the streaming path, or the error it threw
+std::string reduceStream(const std::string& equation) {
+  try {
+    Parser      par{equation};
+    Interpreter interp{};
+    interp.reduce(par);
+    interp.solve();
+    std::ostringstream os;
+    for (const auto& solution : interp.getSolutions()) {
+      std::visit([&os](const auto& s) { os << s << ' '; }, solution);
+    }
+    return os.str();
+  } catch (const std::exception& e) {
+    return e.what();
+  }
+}
+
+}  // namespace
+
+TEST(interpreter, streamingMatchesTree) {
+  const std::string equations[]{
+      "1 * X^2 - 3 * X^1 - 4 * X^0 = 0",
+      "5 * X^0 + 4 * X^1 - 9.3 * X^2 = 1 * X^0",
+      "84 * X^1 - 20 * X^0 = 42 * X^1 - 10 * X^0",
+      "42 * X^1 - 20 * X^0 = -10 * X^0",
+      "- - 3 * X^2 + 2 * X^1 * 4 * X^0 = - 1 * X^1",
+      "3 * X^2 + 3 * X^1 + 4 * X^0 = 0",
+      "8 * X^0 - 6 * X^1 + 0 * X^2 - 5.6 * X^3 = 3 * X^0",
+      "1 * X^2 + 3000000000 * X^1 = 0",
+      "- 0 * X^1 = 1 * X^0",
+      "1 * X^1 + 2 * X^0",
+      "(X - 1) * (X + 2)^8 = 0",
+      "2 * X^1 - (X - 3)^2 = -(X + 1) * 4",
+  };
+
+  for (const auto& equation : equations) {
+    EXPECT_EQ(reduceTree(equation), reduceStream(equation)) << equation;
+  }
+}
+
+TEST(interpreter, streamingNeedsEquation) {
+  Parser      par{"1 * X^2 + 1 * X^1"};
+  Interpreter interp{};
+
+  EXPECT_THROW(interp.reduce(par), std::invalid_argument);
+}
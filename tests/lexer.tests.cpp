@@ -2,6 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include <clocale>
+#include <string>
+
+#include "symbols.h"
+
 TEST(lexer, defaultConstructor) {
   Lexer lexer{};
   EXPECT_FALSE(lexer.isReady());
@@ -27,15 +32,11 @@ TEST(lexer, getEmpty) {
 }
 
 TEST(lexer, getVariableToken) {
-  std::string input("hello");
-  Lexer       lexer{input};
-  Token       token;
+  Lexer lexer{"hello"};
+  Token token = lexer.get();
 
-  for (size_t i = 0; i < input.size(); ++i) {
-    token = lexer.get();
-    EXPECT_EQ(std::get<char>(token.value), input.at(i));
-    EXPECT_EQ(token.kind, Token::Kind::kVariable);
-  }
+  EXPECT_EQ(symbols::name(std::get<char>(token.value)), "hello");
+  EXPECT_EQ(token.kind, Token::Kind::kVariable);
   token = lexer.get();
   EXPECT_EQ(token.kind, Token::Kind::kEnd);
   EXPECT_EQ(std::get<std::monostate>(token.value), std::monostate{});
@@ -97,7 +98,7 @@ TEST(lexer, getAllTokenKinds) {
 }
 
 TEST(lexer, peek) {
-  Lexer lexer{"hello"};
+  Lexer lexer{"h e l l o"};
 
   Token token = lexer.peek();
   EXPECT_EQ(std::get<char>(token.value), 'h');
@@ -136,3 +137,116 @@ TEST(lexer, peek) {
   EXPECT_EQ(std::get<std::monostate>(token.value), std::monostate{});
   EXPECT_EQ(token.kind, Token::Kind::kEnd);
 }
+
+TEST(lexer, tokenOffsets) {
+  Lexer lexer{"12.5 * X^2"};
+
+  EXPECT_EQ(lexer.get().offset, 0);
+  EXPECT_EQ(lexer.get().offset, 5);
+  EXPECT_EQ(lexer.get().offset, 7);
+  EXPECT_EQ(lexer.get().offset, 8);
+  EXPECT_EQ(lexer.get().offset, 9);
+  EXPECT_EQ(lexer.get().offset, 10);
+}
+
+TEST(lexer, unsupportedCharacterColumn) {
+  Lexer lexer{"1 # 2"};
+
+  lexer.get();
+  try {
+    lexer.get();
+    FAIL();
+  } catch (const grammarError &e) {
+    EXPECT_STREQ(e.what(), "character not supported: # at column 3");
+  }
+}
+
+TEST(lexer, identifiers) {
+  Lexer lexer{"3 * speed^2 = X"};
+
+  lexer.get();
+  lexer.get();
+  Token token = lexer.get();
+  EXPECT_EQ(symbols::name(std::get<char>(token.value)), "speed");
+  EXPECT_EQ(token.offset, 4);
+  lexer.get();
+  lexer.get();
+  lexer.get();
+  token = lexer.get();
+  EXPECT_EQ(std::get<char>(token.value), 'X');
+}
+
+/// @brief only a lone "q" quits; a name starting with q is a variable
+TEST(lexer, quitIsWholeWord) {
+  Lexer lexer{"2 * qty^2 = q"};
+
+  lexer.get();
+  lexer.get();
+  Token token = lexer.get();
+  EXPECT_EQ(token.kind, Token::Kind::kVariable);
+  EXPECT_EQ(symbols::name(std::get<char>(token.value)), "qty");
+  lexer.get();
+  lexer.get();
+  lexer.get();
+  token = lexer.get();
+  EXPECT_EQ(token.kind, Token::Kind::kQuit);
+  EXPECT_EQ(token.offset, 12);
+}
+
+TEST(lexer, viewsPartOfBuffer) {
+  const std::string buffer{"4 * X^2 = 0\n7 * X^1 = 0"};
+  Lexer             lexer{std::string_view{buffer}.substr(0, 11)};
+  Token             token;
+
+  for (int i = 0; i < 7; ++i) {
+    token = lexer.get();
+  }
+  EXPECT_EQ(std::get<double>(token.value), 0);
+  EXPECT_EQ(lexer.get().kind, Token::Kind::kEnd);
+}
+
+TEST(lexer, floatForms) {
+  Lexer lexer{"1. 2.5 0.125 007"};
+
+  EXPECT_EQ(std::get<double>(lexer.get().value), 1);
+  EXPECT_EQ(std::get<double>(lexer.get().value), 2.5);
+  EXPECT_EQ(std::get<double>(lexer.get().value), 0.125);
+  EXPECT_EQ(std::get<double>(lexer.get().value), 7);
+  EXPECT_EQ(lexer.get().kind, Token::Kind::kEnd);
+}
+
+TEST(lexer, noExponentNotation) {
+  Lexer lexer{"1e5"};
+
+  EXPECT_EQ(std::get<double>(lexer.get().value), 1);
+  EXPECT_EQ(lexer.get().kind, Token::Kind::kVariable);
+}
+
+TEST(lexer, ignoresLocale) {
+  const char *previous = std::setlocale(LC_NUMERIC, "de_DE.UTF-8");
+  Lexer       lexer{"9.3"};
+
+  EXPECT_EQ(std::get<double>(lexer.get().value), 9.3);
+  if (previous) {
+    std::setlocale(LC_NUMERIC, "C");
+  }
+}
+
+TEST(lexer, overflow) {
+  const std::string huge(400, '9');
+  Lexer             lexer{huge};
+
+  EXPECT_THROW(lexer.get(), grammarError);
+}
+
+TEST(lexer, underflow) {
+  const std::string tiny{"0." + std::string(400, '0') + "1"};
+  Lexer             lexer{tiny};
+
+  try {
+    lexer.get();
+    FAIL();
+  } catch (const grammarError &e) {
+    EXPECT_STREQ(e.what(), "number underflows a double at column 1");
+  }
+}
@@ -0,0 +1,62 @@
+#include "numeric.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+/* power */
+
+static_assert(numeric::power(2, 10) == 1024);
+static_assert(numeric::power(-3, 3) == -27);
+static_assert(numeric::power(0, 0) == 1);
+
+TEST(power, matchesPow) {
+  for (unsigned n = 0; n < 64; ++n) {
+    EXPECT_EQ(numeric::power(2, n), std::pow(2, n));
+  }
+}
+
+/* square root */
+
+TEST(sqrt, correctlyRounded) {
+  EXPECT_EQ(numeric::sqrt(2), std::sqrt(2.0));
+  EXPECT_EQ(numeric::sqrt(39), std::sqrt(39.0));
+}
+
+/* discriminant */
+
+TEST(discriminant, exact) { EXPECT_EQ(numeric::discriminant(1, 4, 4), 0); }
+
+TEST(discriminant, nearlyCancels) {
+  // b * b and 4 * a * c agree in all but their lowest bits: the naive
+  // difference rounds to 0 while the exact discriminant is 2^-54
+  const double b = 1 + std::ldexp(1.0, -27);
+  const double c = std::ldexp(1.0 + std::ldexp(1.0, -26), -2);
+
+  EXPECT_EQ(b * b - 4 * c, 0);
+  EXPECT_EQ(numeric::discriminant(1, b, c), std::ldexp(1.0, -54));
+}
+
+/* quadratic roots */
+
+TEST(quadratic_roots, noCancellation) {
+  // x^2 + 1e8 x + 1 = 0 has a root at about -1e-8, which the classic formula
+  // loses to cancellation
+  double plus{0};
+  double minus{0};
+
+  numeric::quadratic_roots(1, 1e8, 1,
+                           numeric::sqrt(numeric::discriminant(1, 1e8, 1)),
+                           plus, minus);
+  EXPECT_DOUBLE_EQ(plus, -1e-8);
+  EXPECT_DOUBLE_EQ(minus, -1e8);
+}
+
+TEST(quadratic_roots, negativeB) {
+  double plus{0};
+  double minus{0};
+
+  numeric::quadratic_roots(1, -3, 2, 1, plus, minus);
+  EXPECT_EQ(plus, 2);
+  EXPECT_EQ(minus, 1);
+}
@@ -2,6 +2,29 @@
 
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+#include <string>
+
+#include "visitors.h"
+
+namespace {
+
+/// @brief the reduced form of the streaming parser, "c0 c1 ..." by exponent
+std::string reduced(const std::string &equation) {
+  Parser      par{equation};
+  RpnVisitor  rpn{};
+  std::string result;
+
+  par.reduce(rpn);
+  rpn.terms.forEach([&result](const Term &term) {
+    result += std::to_string(term.getExp()) + ":" +
+              std::to_string(static_cast<int>(term.getCoe())) + " ";
+  });
+  return result;
+}
+
+}  // namespace
+
 TEST(parser, noTokens) {
   Parser par{};
   EXPECT_THROW(par.parse(), std::invalid_argument);
@@ -26,3 +49,54 @@ TEST(parser, missingExponent) {
   Parser par{"1 * X^"};
   EXPECT_THROW(par.parse(), grammarError);
 }
+
+TEST(parser, errorColumn) {
+  Parser par{"1 * X^2 + 3 * ^2 = 0"};
+
+  try {
+    par.parse();
+    FAIL();
+  } catch (const grammarError &e) {
+    EXPECT_STREQ(e.what(),
+                 "missing variable in term (ex. 42 * \"X\"^2) at column 15");
+  }
+}
+
+TEST(parser, groupsMultiplyOut) {
+  EXPECT_EQ(reduced("(X - 1) * (X + 2)^2 = 0"), "0:-4 2:3 3:1 ");
+  EXPECT_EQ(reduced("(1 * X^1 - 1 * X^0) * 2 = 0"), "0:-2 1:2 ");
+  EXPECT_EQ(reduced("3 * X^1 * (X + 1) = 0"), "1:3 2:3 ");
+  EXPECT_EQ(reduced("(2 * X^3 + 4 * X^2) / (2 * X^2) = 0"), "0:2 1:1 ");
+  EXPECT_EQ(reduced("((X + 1) * (X - 1))^2 = 1 * X^0"), "2:-2 4:1 ");
+}
+
+/// @brief a group is folded like its terms written out in its place
+TEST(parser, groupsFoldLikeTerms) {
+  EXPECT_EQ(reduced("1 * X^2 - (X - 1)^2 = 0"),
+            reduced("1 * X^2 - 1 * X^2 + 2 * X^1 - 1 * X^0 = 0"));
+  EXPECT_EQ(reduced("1 * X^0 = (X + 1)^2"),
+            reduced("1 * X^0 = 1 * X^0 + 2 * X^1 + 1 * X^2"));
+  EXPECT_EQ(reduced("1 * X^0 = -(X + 1)"), "0:2 1:1 ");
+}
+
+TEST(parser, groupErrors) {
+  RpnVisitor rpn{};
+  Status     status{};
+
+  for (const auto &[equation, code] :
+       {std::pair{"(X + 1 = 0", Errc::kMissingParenthesis},
+        {"(X + Y) * X = 0", Errc::kUnlikeVariables},
+        {"(X + 1) / X = 0", Errc::kIndivisible},
+        {"(X + 1) / 0 = 0", Errc::kIndivisible},
+        {"(2 + 3) = 1 * X^0", Errc::kMissingVariable},
+        {"(X + 1)^1.5 = 0", Errc::kMissingExponent},
+        {"(X + 1)^2000000 = 0", Errc::kDegreeTooBig},
+        {"(X + 1)^40 = 0", Errc::kTooBig}}) {
+    Parser par{equation};
+
+    status = {};
+    EXPECT_FALSE(par.reduce(rpn, status)) << equation;
+    EXPECT_EQ(status.code, code) << equation;
+  }
+  EXPECT_THROW(Parser{"(X + 1 = 0"}.parse(), grammarError);
+}
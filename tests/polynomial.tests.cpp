@@ -0,0 +1,136 @@
+#include "polynomial.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+
+std::vector<Term> terms(const Polynomial &polynomial) {
+  std::vector<Term> result;
+
+  polynomial.forEach([&result](const Term &term) { result.push_back(term); });
+  return result;
+}
+
+Term term(const double coe, const char var, const int exp) {
+  Term result{coe};
+
+  result.setVar(var);
+  result.setExp(exp);
+  return result;
+}
+
+}  // namespace
+
+TEST(polynomial, addsLikeTerms) {
+  Polynomial terms{};
+
+  terms.add(Term{2, 'X', 1});
+  terms.add(Term{3, 'X', 1});
+  EXPECT_EQ(terms.find('X', 1), 5);
+  EXPECT_EQ(terms.size(), 1);
+}
+
+TEST(polynomial, cancelledTermsAreAbsent) {
+  Polynomial terms{};
+
+  terms.add(Term{2, 'X', 2});
+  terms.add(Term{-2, 'X', 2});
+  EXPECT_TRUE(terms.empty());
+  EXPECT_EQ(terms.find('X', 2), 0);
+  EXPECT_TRUE(::terms(terms).empty());
+}
+
+TEST(polynomial, zeroExponentsOfDifferentVariables) {
+  Polynomial terms{};
+
+  terms.add(Term{1, 'X', 0});
+  terms.add(Term{2, 'Y', 0});
+  terms.add(Term{4});
+  EXPECT_EQ(terms.size(), 3);
+  EXPECT_EQ(terms.find('X', 0), 1);
+  EXPECT_EQ(terms.find('Y', 0), 2);
+  EXPECT_EQ(terms.find(0, 0), 4);
+}
+
+TEST(polynomial, wideExponents) {
+  const int  big = 1 << 20;
+  Polynomial terms{};
+
+  terms.add(Term{1, 'X', 1});
+  terms.add(Term{4, 'Y', 1});
+  terms.add(Term{7, 'X', big + 5});
+  terms.add(Term{-7, 'X', big + 5});
+  terms.add(Term{9, 'X', big});
+  terms.add(term(3, 'X', -2));
+  EXPECT_EQ(terms.size(), 4);
+  EXPECT_EQ(terms.find('Y', 1), 4);
+  EXPECT_EQ(terms.find('X', big), 9);
+  EXPECT_EQ(terms.find('X', big - 1), 0);
+  EXPECT_EQ(terms.find('X', -2), 3);
+}
+
+/// @brief every letter, and the growth of the table
+TEST(polynomial, manyVariables) {
+  Polynomial terms{};
+
+  for (int exp = 0; exp < 40; ++exp) {
+    for (char var = 'A'; var <= 'Z'; ++var) {
+      terms.add(Term{1, var, exp});
+      terms.add(Term{static_cast<double>(exp), var, exp});
+    }
+  }
+  EXPECT_EQ(terms.size(), 26 * 40);
+  for (char var = 'A'; var <= 'Z'; ++var) {
+    EXPECT_EQ(terms.find(var, 0), 1);
+    EXPECT_EQ(terms.find(var, 39), 40);
+  }
+  const std::vector<Term> order = ::terms(terms);
+
+  ASSERT_EQ(order.size(), 26 * 40);
+  EXPECT_EQ(order.front(), (Term{1, 'A', 0}));
+  EXPECT_EQ(order[40], (Term{1, 'B', 0}));
+  EXPECT_EQ(order.back(), (Term{40, 'Z', 39}));
+}
+
+TEST(polynomial, orderedByVariableAndExponent) {
+  const int  big = 1 << 20;
+  Polynomial terms{};
+
+  terms.add(Term{1, 'X', 2});
+  terms.add(Term{2, 'Y', 0});
+  terms.add(Term{3, 'A', 7});
+  terms.add(Term{4, 'X', big});
+  terms.add(Term{5, 'X', 0});
+  const std::vector<Term> order = ::terms(terms);
+
+  ASSERT_EQ(order.size(), 5);
+  EXPECT_EQ(order[0], (Term{3, 'A', 7}));
+  EXPECT_EQ(order[1], (Term{5, 'X', 0}));
+  EXPECT_EQ(order[2], (Term{1, 'X', 2}));
+  EXPECT_EQ(order[3], (Term{4, 'X', big}));
+  EXPECT_EQ(order[4], (Term{2, 'Y', 0}));
+}
+
+TEST(polynomial, set) {
+  Polynomial terms{};
+
+  terms.add(Term{0.1, 'X', 1});
+  terms.add(Term{0.2, 'X', 1});
+  terms.set(Term{0.7, 'X', 1});
+  EXPECT_EQ(terms.find('X', 1), 0.7);
+  terms.set(Term{0, 'X', 1});
+  EXPECT_TRUE(terms.empty());
+}
+
+TEST(polynomial, clear) {
+  Polynomial terms{};
+
+  terms.add(Term{1, 'X', 2});
+  terms.clear();
+  EXPECT_TRUE(terms.empty());
+  terms.add(Term{1, 'Y', 2});
+  EXPECT_EQ(terms.find('Y', 2), 1);
+  EXPECT_EQ(terms.find('X', 2), 0);
+}
@@ -0,0 +1,43 @@
+#include "pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+TEST(threadPool, runsEveryTask) {
+  std::atomic<int> count{0};
+  {
+    ThreadPool pool{4};
+
+    for (int i = 0; i < 1000; ++i) {
+      pool.submit([&count] { ++count; });
+    }
+  }
+  EXPECT_EQ(count, 1000);
+}
+
+TEST(threadPool, tasksCanSubmitTasks) {
+  std::atomic<int> count{0};
+  {
+    ThreadPool pool{2};
+
+    for (int i = 0; i < 100; ++i) {
+      pool.submit([&pool, &count] {
+        pool.submit([&count] { ++count; });
+        ++count;
+      });
+    }
+  }
+  EXPECT_EQ(count, 200);
+}
+
+TEST(threadPool, zeroThreadsStillRuns) {
+  std::atomic<int> count{0};
+  {
+    ThreadPool pool{0};
+
+    EXPECT_EQ(pool.size(), 1);
+    pool.submit([&count] { ++count; });
+  }
+  EXPECT_EQ(count, 1);
+}
@@ -0,0 +1,220 @@
+#include "precision.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <variant>
+#include <vector>
+
+#include "numeric.h"
+#include "utils.h"
+
+namespace {
+
+/// @brief the outputs come first, so they are set before escalate runs
+struct Solution {
+  double          root1{0};
+  double          root2{0};
+  double          imag{0};
+  utils::Roots    kind{utils::Roots::kNone};
+  precision::Tier tier;
+
+  Solution(const double a, const double b, const double c)
+      : tier{precision::escalate(a, b, c, root1, root2, imag, kind)} {}
+};
+
+bool certain(const double a, const double b, const double c) {
+  bool result{false};
+
+  numeric::discriminant(a, b, c, result);
+  return result;
+}
+
+}  // namespace
+
+TEST(precision, doubleTierIsCertain) {
+  EXPECT_TRUE(certain(1, -3, 2));
+  EXPECT_TRUE(certain(1, 4, 4));
+  EXPECT_TRUE(certain(3, 0, 0));
+  EXPECT_TRUE(certain(1, 1e8, 1));
+  EXPECT_FALSE(certain(1e-200, 0, 1e-200));
+  EXPECT_FALSE(certain(1, 1e200, 1));
+  EXPECT_FALSE(certain(1, 1e-280, 0));
+}
+
+/// @brief 4ac underflows to 0 in double, which takes x^2 + 1 for a double
+/// root at 0
+TEST(precision, underflow) {
+  const Solution solution{1e-200, 0, 1e-200};
+
+  EXPECT_EQ(solution.tier, precision::Tier::kDoubleDouble);
+  EXPECT_EQ(solution.kind, utils::Roots::kComplex);
+  EXPECT_EQ(solution.root1, 0);
+  EXPECT_EQ(solution.imag, 1);
+
+  const auto roots = utils::quadratic_equation_solver(1, 1e-280, 0);
+
+  ASSERT_EQ(roots.size(), 2u);
+  EXPECT_EQ(std::get<double>(roots[0]), 0);
+  EXPECT_EQ(std::get<double>(roots[1]), -1e-280);
+}
+
+TEST(precision, overflow) {
+  const auto roots = utils::quadratic_equation_solver(1, 1e200, 1);
+
+  ASSERT_EQ(roots.size(), 2u);
+  EXPECT_DOUBLE_EQ(std::get<double>(roots[0]), -1e-200);
+  EXPECT_DOUBLE_EQ(std::get<double>(roots[1]), -1e200);
+
+  const Solution solution{1, 0x1p600, 0x1p-300};
+
+  EXPECT_EQ(solution.tier, precision::Tier::kDoubleDouble);
+  EXPECT_EQ(solution.root1, -0x1p-900);
+  EXPECT_EQ(solution.root2, -0x1p600);
+}
+
+/// @brief b^2 and 4ac agree to all but their last bits; the expected roots
+/// are the exact ones, correctly rounded
+TEST(precision, cancellation) {
+  const Solution real{0x1.d508fc881e90cp+0, 0x1.f4bcec7689362p+1,
+                      0x1.0b4ab727f4979p+1};
+
+  EXPECT_EQ(real.tier, precision::Tier::kDoubleDouble);
+  EXPECT_EQ(real.kind, utils::Roots::kReal);
+  EXPECT_EQ(real.root1, -0x1.114db06b65f73p+0);
+  EXPECT_EQ(real.root2, -0x1.114db0ab399aap+0);
+
+  const Solution complex{0x1.b4609e4479253p+0, 0x1.e190da0165d32p+1,
+                         0x1.09b7820e64dbfp+1};
+
+  EXPECT_EQ(complex.kind, utils::Roots::kComplex);
+  EXPECT_EQ(complex.root1, -0x1.1a827b8c50356p+0);
+  EXPECT_EQ(complex.imag, 0x1.c37ab289aaeffp-28);
+}
+
+/// @brief b^2 and 4ac round apart, and their rounding errors to almost the
+/// same apart, so neither double nor double-double bounds the discriminant,
+/// which is 1
+TEST(precision, exact) {
+  const double   b{0x9000000000001p0};
+  const Solution solution{(b - 1) / 2, b, (b + 1) / 2};
+
+  EXPECT_FALSE(certain((b - 1) / 2, b, (b + 1) / 2));
+  EXPECT_EQ(solution.tier, precision::Tier::kExact);
+  EXPECT_EQ(solution.kind, utils::Roots::kReal);
+  EXPECT_EQ(solution.root1, -1);
+  EXPECT_EQ(solution.root2, -0x1.0000000000004p+0);
+}
+
+/// @brief coefficients 2^1600 apart or more: every intermediate of a naive
+/// scaling under- or overflows, while the roots only do where they must
+TEST(precision, extremeSpread) {
+  const Solution lopsided{1, 1e200, 1e-300};
+
+  EXPECT_EQ(lopsided.kind, utils::Roots::kReal);
+  EXPECT_EQ(lopsided.root1, 0);
+  EXPECT_EQ(lopsided.root2, -1e200);
+
+  const Solution wider{1, 1e300, 1e-300};
+
+  EXPECT_EQ(wider.root1, 0);
+  EXPECT_EQ(wider.root2, -1e300);
+
+  const Solution overflowing{1e-300, 1e200, 1};
+
+  EXPECT_DOUBLE_EQ(overflowing.root1, -1e-200);
+  EXPECT_EQ(overflowing.root2, -std::numeric_limits<double>::infinity());
+
+  const Solution opposite{1e-300, 0, -1e300};
+
+  EXPECT_DOUBLE_EQ(opposite.root1, 1e300);
+  EXPECT_DOUBLE_EQ(opposite.root2, -1e300);
+
+  const Solution complex{1e300, 1, 1e-300};
+
+  EXPECT_EQ(complex.kind, utils::Roots::kComplex);
+  EXPECT_DOUBLE_EQ(complex.root1, -0.5e-300);
+  EXPECT_DOUBLE_EQ(complex.imag, std::sqrt(3.0) * 0.5e-300);
+
+  const auto roots = utils::quadratic_equation_solver(1, 1e200, 1e-300);
+
+  ASSERT_EQ(roots.size(), 2u);
+  EXPECT_EQ(std::get<double>(roots[0]), 0);
+  EXPECT_EQ(std::get<double>(roots[1]), -1e200);
+}
+
+/// @brief random coefficients over the whole exponent range, against the
+/// same formulas in an extended precision whose exponent range holds them
+TEST(precision, randomSpread) {
+  using extended = long double;
+
+  if (std::numeric_limits<extended>::max_exponent < 4096) {
+    GTEST_SKIP() << "long double has the exponent range of double";
+  }
+  std::mt19937                           engine{42};
+  std::uniform_real_distribution<double> fraction{1, 2};
+  std::uniform_int_distribution<int>     exponent{-1000, 1000};
+  std::bernoulli_distribution            negative{0.5};
+  const auto                             coefficient = [&] {
+    const double x = std::ldexp(fraction(engine), exponent(engine));
+
+    return negative(engine) ? -x : x;
+  };
+  const auto expect = [](const double actual, const extended exact) {
+    const auto rounded = static_cast<double>(exact);
+
+    if (std::isinf(rounded)) {
+      EXPECT_EQ(actual, rounded);
+    } else {
+      EXPECT_NEAR(actual, rounded, 1e-12 * std::abs(rounded) + 0x1p-1073);
+    }
+  };
+
+  for (int i = 0; i < 10000; ++i) {
+    const double   a = coefficient();
+    const double   b = coefficient();
+    const double   c = coefficient();
+    const Solution solution{a, b, c};
+    const extended discriminant =
+        extended{b} * b - 4 * extended{a} * extended{c};
+
+    if (discriminant > 0) {
+      const extended q =
+          -(b + std::copysign(std::sqrt(discriminant), extended{b})) / 2;
+
+      ASSERT_EQ(solution.kind, utils::Roots::kReal);
+      expect(b < 0 ? solution.root1 : solution.root2, q / a);
+      expect(b < 0 ? solution.root2 : solution.root1, c / q);
+    } else {
+      ASSERT_EQ(solution.kind, utils::Roots::kComplex);
+      expect(solution.root1, -b / (2 * extended{a}));
+      expect(solution.imag, std::sqrt(-discriminant) / (2 * extended{a}));
+    }
+  }
+}
+
+TEST(precision, leavesNonFinite) {
+  EXPECT_EQ(Solution(1, std::numeric_limits<double>::infinity(), 1).tier,
+            precision::Tier::kDouble);
+  EXPECT_EQ(Solution(0, 1, 1).tier, precision::Tier::kDouble);
+}
+
+TEST(precision, countsTiers) {
+  if (!stats::compiled) {
+    GTEST_SKIP() << "built with COMPUTORV1_STATS=OFF";
+  }
+  stats::reset();
+  stats::enable();
+  utils::quadratic_equation_solver(1, -3, 2);
+  utils::quadratic_equation_solver(1, 0, 0);
+  utils::quadratic_equation_solver(1, 1e200, 1);
+  utils::quadratic_equation_solver(1266637395197952, 0x9000000000001p0,
+                                   1266637395197953);
+  stats::enable(false);
+
+  EXPECT_EQ(stats::counter(stats::Counter::kDoubleSolves), 2u);
+  EXPECT_EQ(stats::counter(stats::Counter::kDoubleDoubleSolves), 1u);
+  EXPECT_EQ(stats::counter(stats::Counter::kExactSolves), 1u);
+}
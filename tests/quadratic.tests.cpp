@@ -0,0 +1,139 @@
+#include "quadratic.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "utils.h"
+
+namespace {
+
+struct Batch {
+  std::vector<double>       root1;
+  std::vector<double>       root2;
+  std::vector<double>       imag;
+  std::vector<utils::Roots> kind;
+
+  Batch(const std::vector<double>& a, const std::vector<double>& b,
+        const std::vector<double>& c)
+      : root1(a.size()), root2(a.size()), imag(a.size()), kind(a.size()) {
+    utils::quadratic_batch_solver(a.data(), b.data(), c.data(), a.size(),
+                                  root1.data(), root2.data(), imag.data(),
+                                  kind.data());
+  }
+};
+
+}  // namespace
+
+TEST(quadratic_batch_solver, classifies) {
+  Batch batch{{1, 1, 3, 0, 1}, {1, 4, 3, 2, 0}, {0, 4, 4, 1, 0}};
+
+  EXPECT_EQ(batch.kind[0], utils::Roots::kReal);
+  EXPECT_EQ(batch.root1[0], 0);
+  EXPECT_EQ(batch.root2[0], -1);
+  EXPECT_EQ(batch.kind[1], utils::Roots::kDouble);
+  EXPECT_EQ(batch.root1[1], -2);
+  EXPECT_EQ(batch.kind[2], utils::Roots::kComplex);
+  EXPECT_EQ(batch.root1[2], -0.5);
+  EXPECT_EQ(batch.imag[2], std::sqrt(39.0) / 6);
+  EXPECT_EQ(batch.kind[3], utils::Roots::kNone);
+  EXPECT_EQ(batch.kind[4], utils::Roots::kDouble);
+  EXPECT_EQ(batch.root1[4], 0);
+}
+
+/// @brief every lane and the scalar tail agree with the scalar solver
+TEST(quadratic_batch_solver, matchesScalarSolver) {
+  std::vector<double> a;
+  std::vector<double> b;
+  std::vector<double> c;
+
+  for (int i = 0; i < 37; ++i) {
+    a.push_back(i % 5 - 2.5);
+    b.push_back(i % 7 - 3);
+    c.push_back(i % 3 - 1.25);
+  }
+  Batch batch{a, b, c};
+
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    const auto expected = utils::quadratic_equation_solver(a[i], b[i], c[i]);
+
+    if (expected.size() == 1) {
+      EXPECT_EQ(batch.kind[i], utils::Roots::kDouble);
+      EXPECT_NEAR(batch.root1[i], std::get<double>(expected[0]), 1e-6);
+    } else if (std::holds_alternative<double>(expected[0])) {
+      EXPECT_EQ(batch.kind[i], utils::Roots::kReal);
+      EXPECT_NEAR(batch.root1[i], std::get<double>(expected[0]), 1e-6);
+      EXPECT_NEAR(batch.root2[i], std::get<double>(expected[1]), 1e-6);
+    } else {
+      EXPECT_EQ(batch.kind[i], utils::Roots::kComplex);
+      EXPECT_EQ(batch.root1[i], std::get<utils::Complex>(expected[1]).real);
+      EXPECT_NEAR(batch.imag[i], std::get<utils::Complex>(expected[1]).imag,
+                  1e-6);
+    }
+  }
+}
+
+/// @brief lanes use the cancellation-free formula and the compensated
+/// discriminant, like the scalar solver
+TEST(quadratic_batch_solver, noCancellation) {
+  const double        b = 1 + std::ldexp(1.0, -27);
+  const double        c = std::ldexp(1.0 + std::ldexp(1.0, -26), -2);
+  const std::size_t   n = 17;
+  std::vector<double> as(n, 1);
+  std::vector<double> bs(n);
+  std::vector<double> cs(n);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    bs[i] = i % 2 ? 1e8 : -b;
+    cs[i] = i % 2 ? 1 : c;
+  }
+  Batch batch{as, bs, cs};
+
+  for (std::size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(batch.kind[i], utils::Roots::kReal);
+    if (i % 2) {
+      EXPECT_DOUBLE_EQ(batch.root1[i], -1e-8);
+      EXPECT_DOUBLE_EQ(batch.root2[i], -1e8);
+    } else {
+      EXPECT_EQ(batch.root1[i], b / 2 + std::ldexp(1.0, -28));
+      EXPECT_EQ(batch.root2[i], b / 2 - std::ldexp(1.0, -28));
+    }
+  }
+}
+
+/// @brief lanes and the tail whose discriminant is doubtful are solved by
+/// the precision tiers, like the scalar solver
+TEST(quadratic_batch_solver, escalatesDoubtful) {
+  const std::vector<double> doubtful[] = {
+      {1e-200, 0, 1e-200},
+      {1, 1e200, 1},
+      {0x1.d508fc881e90cp+0, 0x1.f4bcec7689362p+1, 0x1.0b4ab727f4979p+1},
+      {0x1.b4609e4479253p+0, 0x1.e190da0165d32p+1, 0x1.09b7820e64dbfp+1}};
+  const std::size_t   lanes[] = {0, 5, 10, 16};
+  std::vector<double> a(17, 1);
+  std::vector<double> b(17, -3);
+  std::vector<double> c(17, 2);
+
+  for (std::size_t j = 0; j < 4; ++j) {
+    a[lanes[j]] = doubtful[j][0];
+    b[lanes[j]] = doubtful[j][1];
+    c[lanes[j]] = doubtful[j][2];
+  }
+  Batch batch{a, b, c};
+
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    const auto expected = utils::quadratic_equation_solver(a[i], b[i], c[i]);
+
+    if (std::holds_alternative<double>(expected[0])) {
+      EXPECT_EQ(batch.root1[i], std::get<double>(expected[0])) << i;
+      EXPECT_EQ(batch.root2[i], std::get<double>(expected.back())) << i;
+    } else {
+      EXPECT_EQ(batch.kind[i], utils::Roots::kComplex) << i;
+      EXPECT_EQ(batch.root1[i], std::get<utils::Complex>(expected[1]).real);
+      EXPECT_EQ(batch.imag[i], std::get<utils::Complex>(expected[1]).imag);
+    }
+  }
+  EXPECT_EQ(batch.kind[0], utils::Roots::kComplex);
+  EXPECT_EQ(batch.imag[0], 1);
+}
@@ -0,0 +1,115 @@
+#include "repl.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+namespace {
+
+/// @brief redirects std::cout and std::cerr for the lifetime of a test
+struct Captured {
+  std::ostringstream out;
+  std::ostringstream err;
+  std::streambuf    *cout{std::cout.rdbuf(out.rdbuf())};
+  std::streambuf    *cerr{std::cerr.rdbuf(err.rdbuf())};
+
+  ~Captured() {
+    std::cout.rdbuf(cout);
+    std::cerr.rdbuf(cerr);
+  }
+};
+
+}  // namespace
+
+TEST(repl, evaluatesLinesUntilQuit) {
+  Captured captured{};
+  Repl     repl{};
+
+  EXPECT_TRUE(repl.step("1 * X^2 - 4 * X^0 = 0"));
+  EXPECT_TRUE(repl.step("2 * X^1 = 4 * X^0"));
+  EXPECT_FALSE(repl.step("q"));
+  EXPECT_EQ(captured.out.str(),
+            "Reduced form: -4 * X^0 + 1 * X^2 = 0\n"
+            "Polynomial degree: 2\n"
+            "The solutions are:\n"
+            "2\n"
+            "-2\n"
+            "Reduced form: -4 * X^0 + 2 * X^1 = 0\n"
+            "Polynomial degree: 1\n"
+            "The solution is:\n"
+            "-2\n"
+            "quiting computorv1\n");
+}
+
+TEST(repl, errorsDoNotEndTheLoop) {
+  Captured captured{};
+  Repl     repl{};
+
+  EXPECT_TRUE(repl.step("1 * X"));
+  EXPECT_TRUE(repl.step("1 * X^1 = 1 * Y^1"));
+  EXPECT_TRUE(repl.step("1 * X^0 = 1 * X^0"));
+  EXPECT_EQ(captured.err.str(),
+            "missing caret in term (ex. 42 * X\"^\"2) at column 6\n"
+            "can not solve equation with different variables\n");
+  EXPECT_NE(captured.out.str().find("All real numbers"), std::string::npos);
+}
+
+TEST(repl, previousEquationIsForgotten) {
+  Captured captured{};
+  Repl     repl{};
+
+  repl.step("5 * X^2 = 0");
+  captured.out.str("");
+  repl.step("1 * X^1 = 3 * X^0");
+  EXPECT_EQ(captured.out.str(),
+            "Reduced form: -3 * X^0 + 1 * X^1 = 0\n"
+            "Polynomial degree: 1\n"
+            "The solution is:\n"
+            "-3\n");
+}
+
+/// @brief a session is not bounded by the names one equation can hold, also
+/// when each line only edits the name of one operand
+TEST(repl, namesPerLine) {
+  Captured captured{};
+  Repl     repl{};
+
+  for (int i = 0; i < 300; ++i) {
+    const std::string name{"v" + std::string(1, 'a' + i % 26) +
+                           std::string(1, 'a' + i / 26)};
+
+    repl.step("2 * " + name + "^1 = 0");
+  }
+  EXPECT_EQ(captured.err.str(), "");
+  EXPECT_NE(captured.out.str().find("Reduced form: 2 * vnl^1 = 0"),
+            std::string::npos);
+}
+
+/// @brief lines reduced from the previous one print what reducing them whole
+/// prints, errors included
+TEST(repl, incrementalMatchesWhole) {
+  const char *lines[]{
+      "1 * X^2 - 4 * X^0 = 0",           "1 * X^2 - 9 * X^0 = 0",
+      "1 * X^2 - 9.5 * X^0 = 0",         "1 * X^2 - 9.5 * X^0 = 3 * X^1",
+      "1 * X^2 - 9.5 * X^0 = 3 * X^ ",   "1 * X^2 - 9.5 * X^0 = 3 * X^1",
+      "1 * X^2 - 9.5 * X^0 = 3 * Y^1",   "1 * X^3 - 9.5 * X^0 = 3 * X^1",
+      "1 * X^0 - 9.5 * X^0 = 3 * X^0",   "0 * X^0 - 9.5 * X^0 = 3 * X^0",
+      "1 * X^2 - 0 * X^0 = 3 * X^0",     "q"};
+  std::string output[2];
+  std::string errors[2];
+
+  for (const bool incremental : {false, true}) {
+    Captured captured{};
+    Repl     repl{};
+
+    repl.setIncremental(incremental);
+    for (const char *line : lines) {
+      repl.step(line);
+    }
+    output[incremental] = captured.out.str();
+    errors[incremental] = captured.err.str();
+  }
+  EXPECT_EQ(output[1], output[0]);
+  EXPECT_EQ(errors[1], errors[0]);
+  EXPECT_NE(errors[0].find("can not negate zero"), std::string::npos);
+}
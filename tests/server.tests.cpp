@@ -0,0 +1,124 @@
+#include "server.h"
+
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+/// @brief a server running on its own thread, stopped at the end of a test
+struct Running {
+  std::string    path{testing::TempDir() + "computorv1_" +
+                   testing::UnitTest::GetInstance()->current_test_info()->name() +
+                   ".sock"};
+  SolutionCache  cache{64};
+  server::Server server{path, 2, cache};
+  std::thread    thread{[this] { server.run(); }};
+
+  ~Running() {
+    server.stop();
+    thread.join();
+  }
+};
+
+int connect(const std::string& path) {
+  sockaddr_un address{};
+  const int   fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+  EXPECT_EQ(::connect(fd, reinterpret_cast<const sockaddr*>(&address),
+                      sizeof(address)),
+            0);
+  return fd;
+}
+
+/// @brief send every request, close the sending side and read every reply
+/// until the server closes the connection
+std::vector<std::string> talk(const std::string& path,
+                                  const std::string& requests) {
+  const int   fd = connect(path);
+  std::string replies;
+  char        buffer[4096];
+
+  EXPECT_EQ(::send(fd, requests.data(), requests.size(), MSG_NOSIGNAL),
+            static_cast<ssize_t>(requests.size()));
+  ::shutdown(fd, SHUT_WR);
+  for (ssize_t count = 0; (count = ::read(fd, buffer, sizeof(buffer))) > 0;) {
+    replies.append(buffer, static_cast<std::size_t>(count));
+  }
+  ::close(fd);
+
+  std::vector<std::string> lines;
+  for (std::size_t end = 0; (end = replies.find('\n')) != std::string::npos;
+       replies.erase(0, end + 1)) {
+    lines.push_back(replies.substr(0, end));
+  }
+  std::sort(lines.begin(), lines.end());
+  return lines;
+}
+
+}  // namespace
+
+TEST(server, repliesToEveryLine) {
+  Running running{};
+
+  EXPECT_EQ(talk(running.path,
+                     "1 * X^2 - 4 * X^0 = 0\n"
+                     "1 * X\n"
+                     "3 * X^1 = 6 * X^0\n"),
+            (std::vector<std::string>{
+                "1: 2, -2",
+                "2: error: missing caret in term (ex. 42 * X\"^\"2) at column 6",
+                "3: -2"}));
+}
+
+TEST(server, servesClientsConcurrently) {
+  Running                  running{};
+  std::vector<std::thread> clients;
+
+  for (int i = 0; i < 8; ++i) {
+    clients.emplace_back([&running] {
+      std::string requests;
+
+      for (int j = 0; j < 100; ++j) {
+        requests += "2 * X^1 = 4 * X^0\n";
+      }
+      const auto replies = talk(running.path, requests);
+
+      ASSERT_EQ(replies.size(), 100);
+      for (const auto& reply : replies) {
+        EXPECT_TRUE(reply.find(": -2") != std::string::npos ||
+                    reply.find(": error: server busy") != std::string::npos)
+            << reply;
+      }
+    });
+  }
+  for (auto& client : clients) {
+    client.join();
+  }
+  EXPECT_GE(running.cache.hits(), 1);
+}
+
+TEST(server, rejectsOverlongLines) {
+  Running running{};
+
+  EXPECT_EQ(talk(running.path, std::string(server::max_line + 1, '1')),
+            std::vector<std::string>{"1: error: line too long"});
+}
+
+TEST(server, removesSocketOnShutdown) {
+  std::string path;
+  {
+    Running running{};
+
+    path = running.path;
+    EXPECT_EQ(::access(path.c_str(), F_OK), 0);
+  }
+  EXPECT_NE(::access(path.c_str(), F_OK), 0);
+}
@@ -0,0 +1,75 @@
+#include "stats.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "interpreter.h"
+#include "parser.h"
+
+TEST(stats, bucketBounds) {
+  for (std::uint64_t ns = 0; ns < 100000; ns += 7) {
+    const std::size_t bucket = stats::Histogram::bucket(ns);
+
+    EXPECT_LE(ns, stats::Histogram::upper(bucket));
+    if (bucket) {
+      EXPECT_GT(ns, stats::Histogram::upper(bucket - 1));
+    }
+  }
+  EXPECT_LT(stats::Histogram::bucket(~std::uint64_t{0}),
+            stats::Histogram::buckets);
+}
+
+TEST(stats, percentiles) {
+  stats::Histogram histogram{};
+
+  for (std::uint64_t ns = 1; ns <= 1000; ++ns) {
+    histogram.add(ns);
+  }
+  EXPECT_EQ(histogram.count(), 1000u);
+  EXPECT_EQ(histogram.total(), 500500u);
+  EXPECT_EQ(histogram.max(), 1000u);
+  EXPECT_NEAR(histogram.percentile(0.50), 500, 500 * 0.125);
+  EXPECT_NEAR(histogram.percentile(0.99), 990, 990 * 0.125);
+  EXPECT_EQ(histogram.percentile(1.0), 1000u);
+}
+
+TEST(stats, disabledRecordsNothing) {
+  stats::reset();
+  stats::enable(false);
+
+  Parser par{"1 * X^2 = 0"};
+  ASSERT_TRUE(par.parse());
+  EXPECT_EQ(stats::counter(stats::Counter::kEquations), 0u);
+  EXPECT_EQ(stats::histogram(stats::Stage::kParse).count(), 0u);
+}
+
+TEST(stats, countsStages) {
+  if (!stats::compiled) {
+    GTEST_SKIP() << "built with COMPUTORV1_STATS=OFF";
+  }
+  stats::reset();
+  stats::enable();
+  for (const char *line : {"1 * X^2 - 4 * X^0 = 0", "1 * X^2 $", "1 X^2 = 0",
+                           "1 * X^2 + 1 * Y^1 = 0"}) {
+    Parser      par{line};
+    Interpreter interp{};
+    Status      status{};
+
+    if (interp.reduce(par, status)) {
+      interp.solve(status);
+    }
+  }
+  stats::enable(false);
+
+  EXPECT_EQ(stats::counter(stats::Counter::kEquations), 4u);
+  EXPECT_EQ(stats::counter(stats::Counter::kLexErrors), 1u);
+  EXPECT_EQ(stats::counter(stats::Counter::kGrammarErrors), 1u);
+  EXPECT_EQ(stats::counter(stats::Counter::kSolveErrors), 1u);
+  EXPECT_EQ(stats::histogram(stats::Stage::kParse).count(), 4u);
+  EXPECT_EQ(stats::histogram(stats::Stage::kSolve).count(), 2u);
+
+  std::ostringstream os;
+  stats::report(os);
+  EXPECT_NE(os.str().find("solve"), std::string::npos);
+}
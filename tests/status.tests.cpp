@@ -0,0 +1,119 @@
+#include "status.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <typeinfo>
+
+#include "interpreter.h"
+#include "parser.h"
+
+namespace {
+
+/// @brief an invalid equation of every kind the pipeline reports
+constexpr std::string_view invalid[]{
+    "",
+    "1 * X^2 $ 3",
+    "* X^2 = 0",
+    "1 X^2 = 0",
+    "1 * ^2 = 0",
+    "1 * X 2 = 0",
+    "1 * X^ = 0",
+    "1 * X^2 = 0 = 0",
+    "1 * X^2 + 3 * X^1",
+    "- 0 * X^1 = 0",
+    "3000000000 * X^1 = 0",
+    "-3000000000 * X^1 = 0",
+    "1 * X^2 + 1 * Y^1 = 0",
+    "5 * X^0 = 0",
+    "1 * X^1 = "
+    "10000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000",
+};
+
+}  // namespace
+
+TEST(status, noError) {
+  Status status{};
+
+  EXPECT_FALSE(status);
+  EXPECT_EQ(status.code, Errc::kNone);
+}
+
+TEST(status, messages) {
+  EXPECT_EQ((Status{Errc::kUnsupportedCharacter, 3, '$'}.message()),
+            "character not supported: $ at column 4");
+  EXPECT_EQ((Status{Errc::kMissingEnd, 11}.message()),
+            "missing end of equation token at column 12");
+  EXPECT_EQ((Status{Errc::kTooBig}.message()),
+            "number too big, the upper limit is: 2147483647");
+  EXPECT_EQ((Status{Errc::kQuit}.message()), "quit is not an equation");
+}
+
+TEST(status, raise) {
+  EXPECT_THROW((Status{Errc::kMissingNumber}.raise()), grammarError);
+  EXPECT_THROW((Status{Errc::kNotEquation}.raise()), std::invalid_argument);
+  EXPECT_THROW((Status{Errc::kNegateZero}.raise()), std::runtime_error);
+  try {
+    Status{Errc::kTooSmall}.raise();
+  } catch (const std::invalid_argument& e) {
+    EXPECT_STREQ(e.what(),
+                 "number too small, the lower limit is: -2147483648\n");
+  }
+}
+
+TEST(status, emptyInput) {
+  Lexer  lexer{};
+  Status status{};
+
+  EXPECT_EQ(lexer.get(status).kind, Token::Kind::kEnd);
+  EXPECT_EQ(status.code, Errc::kEmptyInput);
+}
+
+TEST(status, quitIsNotAnError) {
+  Parser      par{"q"};
+  Interpreter interp{};
+  Status      status{};
+
+  EXPECT_FALSE(interp.reduce(par, status));
+  EXPECT_FALSE(status);
+}
+
+/// @brief the status path reports what the throwing path throws
+TEST(status, matchesExceptions) {
+  for (const std::string_view line : invalid) {
+    std::string thrown;
+    std::string type;
+
+    try {
+      Parser      par{line};
+      Interpreter interp{};
+
+      interp.reduce(par);
+      interp.solve();
+    } catch (const std::exception& e) {
+      thrown = e.what();
+      type = typeid(e).name();
+    }
+    ASSERT_FALSE(thrown.empty()) << line;
+
+    Parser      par{line};
+    Interpreter interp{};
+    Status      status{};
+
+    if (interp.reduce(par, status)) {
+      interp.solve(status);
+    }
+    ASSERT_TRUE(status) << line;
+    try {
+      status.raise();
+    } catch (const std::exception& e) {
+      EXPECT_EQ(e.what(), thrown) << line;
+      EXPECT_EQ(typeid(e).name(), type) << line;
+    }
+  }
+}
@@ -0,0 +1,78 @@
+#include "symbols.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+namespace {
+
+/// @brief a name of letters only, different for every n
+std::string nth(std::size_t n) {
+  std::string result{"id"};
+
+  for (; n; n /= 26) {
+    result += static_cast<char>('a' + n % 26);
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(symbols, lettersAreThemselves) {
+  Status status{};
+
+  EXPECT_EQ(symbols::intern("X", status), 'X');
+  EXPECT_EQ(symbols::intern("x", status), 'x');
+  EXPECT_FALSE(status);
+  EXPECT_EQ(symbols::name('X'), "X");
+  EXPECT_TRUE(symbols::name(0).empty());
+  EXPECT_TRUE(symbols::name('^').empty());
+}
+
+TEST(symbols, namesAreInternedOnce) {
+  Status                  status{};
+  const symbols::symbol_t speed = symbols::intern("speed", status);
+
+  EXPECT_EQ(symbols::intern("speed", status), speed);
+  EXPECT_NE(symbols::intern("speeds", status), speed);
+  EXPECT_FALSE(status);
+  EXPECT_EQ(symbols::name(speed), "speed");
+}
+
+/// @brief the capacity bounds one equation: a reset makes room again
+TEST(symbols, resetForgetsNames) {
+  Status status{};
+
+  symbols::reset();
+  for (std::size_t i = 0; i < symbols::capacity; ++i) {
+    symbols::intern(nth(i), status);
+  }
+  EXPECT_FALSE(status);
+  EXPECT_EQ(symbols::intern(nth(symbols::capacity), status), 0);
+  EXPECT_EQ(status.code, Errc::kTooManyIdentifiers);
+
+  Status                  fresh{};
+  const symbols::symbol_t first = symbols::intern(nth(0), fresh);
+
+  symbols::reset();
+  EXPECT_TRUE(symbols::name(first).empty());
+  EXPECT_EQ(symbols::intern(nth(symbols::capacity), fresh), first);
+  EXPECT_FALSE(fresh);
+}
+
+TEST(symbols, perThread) {
+  Status status{};
+
+  symbols::reset();
+  const symbols::symbol_t speed = symbols::intern("speed", status);
+
+  std::thread{[speed] {
+    Status other{};
+
+    EXPECT_TRUE(symbols::name(speed).empty());
+    EXPECT_EQ(symbols::intern("time", other), speed);
+    EXPECT_EQ(symbols::name(speed), "time");
+  }}.join();
+  EXPECT_EQ(symbols::name(speed), "speed");
+}
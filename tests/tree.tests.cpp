@@ -0,0 +1,56 @@
+#include "tree.h"
+
+#include <gtest/gtest.h>
+
+#include "parser.h"
+
+TEST(tree, postOrder) {
+  Parser par{"1 * X^2 - 3 * X^1 = 4 * X^0"};
+  par.parse();
+  const Tree& tree = par.getTree();
+
+  ASSERT_EQ(tree.getNodes().size(), 5);
+  EXPECT_EQ(tree.node(0).kind, Node::Kind::kTerm);
+  EXPECT_EQ(tree.node(1).kind, Node::Kind::kTerm);
+  EXPECT_EQ(tree.node(2).kind, Node::Kind::kBinary);
+  EXPECT_EQ(tree.node(2).oper, Token::Kind::kMinus);
+  EXPECT_EQ(tree.node(3).kind, Node::Kind::kTerm);
+  EXPECT_EQ(tree.getRoot(), 4);
+  EXPECT_EQ(tree.node(4).oper, Token::Kind::kEqual);
+  EXPECT_EQ(tree.node(4).left, 2);
+  EXPECT_EQ(tree.node(4).right, 3);
+}
+
+TEST(tree, termPayloads) {
+  Parser par{"- 2 * X^1 = 0"};
+  par.parse();
+  const Tree& tree = par.getTree();
+
+  ASSERT_EQ(tree.getTerms().size(), 2);
+  EXPECT_EQ(tree.getTerms()[0], (Term{2, 'X', 1}));
+  EXPECT_EQ(tree.node(1).kind, Node::Kind::kUnary);
+  EXPECT_EQ(tree.node(1).left, 0);
+  EXPECT_EQ(tree.node(2).left, 1);
+}
+
+TEST(tree, parserReusesStorage) {
+  Parser par{"1 * X^2 = 0"};
+
+  par.parse();
+  const Node* first = par.getTree().getNodes().data();
+  par.stream("1 * X^2 = 0");
+  par.parse();
+  EXPECT_EQ(first, par.getTree().getNodes().data());
+}
+
+TEST(tree, clear) {
+  Tree tree{};
+
+  const Tree::index_t left = tree.term(Term{1, 'X', 1});
+  const Tree::index_t right = tree.term(Term{2, 'X', 0});
+  tree.binary(Token::Kind::kEqual, left, right);
+  EXPECT_FALSE(tree.empty());
+  tree.clear();
+  EXPECT_TRUE(tree.empty());
+  EXPECT_TRUE(tree.getTerms().empty());
+}
@@ -137,9 +137,9 @@ TEST(quadratic_equation_solver, complexSolution) {
   auto actual = utils::quadratic_equation_solver(3, 3, 4);
   EXPECT_EQ(actual.size(), 2);
   EXPECT_EQ(std::get<utils::Complex>(actual.at(0)).real, -0.5);
-  EXPECT_EQ(std::get<utils::Complex>(actual.at(0)).imag, -1.0408330019191296);
+  EXPECT_EQ(std::get<utils::Complex>(actual.at(0)).imag, -std::sqrt(39.0) / 6);
   EXPECT_EQ(std::get<utils::Complex>(actual.at(1)).real, -0.5);
-  EXPECT_EQ(std::get<utils::Complex>(actual.at(1)).imag, 1.0408330019191296);
+  EXPECT_EQ(std::get<utils::Complex>(actual.at(1)).imag, std::sqrt(39.0) / 6);
 }
 
 /* linear equation solver */
@@ -0,0 +1,123 @@
+#include "writer.h"
+
+#include <gtest/gtest.h>
+
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+
+#include "status.h"
+#include "term.h"
+#include "utils.h"
+
+namespace {
+
+template <typename T>
+std::string written(const T &value) {
+  std::string output;
+  {
+    Writer out{output};
+
+    out << value;
+  }
+  return output;
+}
+
+template <typename T>
+std::string streamed(const T &value) {
+  std::ostringstream os;
+
+  os << value;
+  return os.str();
+}
+
+/// @brief restores the default format when a test leaves
+class ShortestFormat {
+ public:
+  ShortestFormat() { Writer::setFormat(Writer::Format::kShortest); }
+  ~ShortestFormat() { Writer::setFormat(Writer::Format::kGeneral); }
+};
+
+}  // namespace
+
+/// @brief the default format writes doubles exactly like std::ostream
+TEST(writer, generalMatchesStream) {
+  std::mt19937                           rng{42};
+  std::uniform_real_distribution<double> mantissa{-10, 10};
+  std::uniform_int_distribution<int>     exponent{-30, 30};
+
+  for (const double value :
+       {0.0, -0.0, 1.0, -4.0, 0.5, 1.04083, 1e-5, 123456.0, 1234567.0, 1e100,
+        std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::denorm_min(),
+        std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity()}) {
+    EXPECT_EQ(written(value), streamed(value));
+  }
+  for (int i = 0; i < 10000; ++i) {
+    const double value = std::ldexp(mantissa(rng), exponent(rng));
+
+    ASSERT_EQ(written(value), streamed(value));
+  }
+}
+
+/// @brief the shortest format reads back to the same double
+TEST(writer, shortestRoundTrips) {
+  const ShortestFormat                   format{};
+  std::mt19937_64                        rng{42};
+  std::uniform_real_distribution<double> value{-1e6, 1e6};
+
+  EXPECT_EQ(written(0.1), "0.1");
+  EXPECT_EQ(written(1.0 / 3), "0.3333333333333333");
+  for (int i = 0; i < 10000; ++i) {
+    const double      expected = value(rng);
+    const std::string text = written(expected);
+    double            actual{};
+
+    std::from_chars(text.data(), text.data() + text.size(), actual);
+    ASSERT_EQ(actual, expected) << text;
+  }
+}
+
+TEST(writer, integersAndText) {
+  EXPECT_EQ(written(0), "0");
+  EXPECT_EQ(written(-42), "-42");
+  EXPECT_EQ(written(std::numeric_limits<std::size_t>::max()),
+            streamed(std::numeric_limits<std::size_t>::max()));
+  EXPECT_EQ(written('x'), "x");
+  EXPECT_EQ(written("text"), "text");
+  EXPECT_EQ(written(std::string_view{"view"}), "view");
+}
+
+/// @brief output larger than the buffer is flushed in order
+TEST(writer, flushesWhenFull) {
+  const std::string  large(Writer::capacity + 17, 'a');
+  std::ostringstream os;
+  std::string        expected;
+  {
+    Writer out{os};
+
+    for (std::size_t i = 0; i < 20000; ++i) {
+      out << i << ' ';
+      expected += std::to_string(i) + ' ';
+    }
+    out << large;
+    out.flush();
+    EXPECT_EQ(os.str(), expected + large);
+    out << "end";
+  }
+  EXPECT_EQ(os.str(), expected + large + "end");
+}
+
+TEST(writer, types) {
+  const Term term{-3.5, 'X', 2};
+
+  EXPECT_EQ(written(term), streamed(term));
+  EXPECT_EQ(written(utils::Complex{-0.5, -1.04083}),
+            streamed(utils::Complex{-0.5, -1.04083}));
+  EXPECT_EQ(written(utils::Complex{0, 2}), streamed(utils::Complex{0, 2}));
+  EXPECT_EQ(written(Status{Errc::kUnsupportedCharacter, 3, '$'}),
+            streamed(Status{Errc::kUnsupportedCharacter, 3, '$'}));
+}